@@ -7,6 +7,10 @@
 #include "systematicstools/utility/printers.hh"
 #include "systematicstools/utility/string_parsers.hh"
 
+#include "nusystematics/app/TweakShardInfo.hh"
+
+#include "nusystematics/utility/BoundedSPSCQueue.hh"
+#include "nusystematics/utility/EventKinematics.hh"
 #include "nusystematics/utility/GENIEUtils.hh"
 #include "nusystematics/utility/enumclass2int.hh"
 
@@ -28,37 +32,30 @@
 
 #include "TChain.h"
 #include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <exception>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace systtools;
 using namespace nusyst;
 
 NEW_SYSTTOOLS_EXCEPT(unexpected_number_of_responses);
+NEW_SYSTTOOLS_EXCEPT(failed_to_commit_output);
 
-struct TweakSummaryTree {
-  TFile *f;
-  TTree *t;
-  TTree *m;
-
-  TweakSummaryTree(std::string const &fname) {
-    f = new TFile(fname.c_str(), "RECREATE");
-    t = new TTree("events", "");
-    m = new TTree("tweak_metadata", "");
-    t->SetDirectory(f);
-  }
-  ~TweakSummaryTree() {
-    f->Write();
-    f->Close();
-    delete f;
-  }
-
+/// Per-event quantities written alongside the tweak responses.
+struct EventSummary {
+  Long64_t entry_index;
   int nu_pdg;
   double e_nu_GeV;
   int tgt_A;
@@ -75,6 +72,24 @@ struct TweakSummaryTree {
   double q0_GeV;
   double q3_GeV;
   double EAvail_GeV;
+};
+
+struct TweakSummaryTree : public EventSummary {
+  TFile *f;
+  TTree *t;
+  TTree *m;
+
+  TweakSummaryTree(std::string const &fname) {
+    f = new TFile(fname.c_str(), "RECREATE");
+    t = new TTree("events", "");
+    m = new TTree("tweak_metadata", "");
+    t->SetDirectory(f);
+  }
+  ~TweakSummaryTree() {
+    f->Write();
+    f->Close();
+    delete f;
+  }
 
   std::vector<int> ntweaks;
   std::vector<std::vector<double>> tweak_branches;
@@ -86,6 +101,7 @@ struct TweakSummaryTree {
   std::vector<double> meta_tweak_values;
 
   void AddBranches(ParamHeaderHelper const &phh) {
+    t->Branch("entry_index", &entry_index, "entry_index/L");
     t->Branch("nu_pdg", &nu_pdg, "nu_pdg/I");
     t->Branch("e_nu_GeV", &e_nu_GeV, "e_nu_GeV/D");
     t->Branch("tgt_A", &tgt_A, "tgt_A/I");
@@ -225,6 +241,13 @@ std::string outputfile = "";
 std::string envvar = "FHICL_FILE_PATH";
 std::string fhicl_key = "generated_systematic_provider_configuration";
 size_t NMax = std::numeric_limits<size_t>::max();
+size_t shard_k = 0;
+size_t shard_N = 0;
+size_t first_entry = 0;
+size_t end_entry = std::numeric_limits<size_t>::max();
+size_t CheckpointEvery = 0;
+bool Resume = false;
+size_t QueueDepth = 64;
 #ifndef NO_ART
 int lookup_policy = 1;
 #endif
@@ -252,6 +275,20 @@ void SayUsage(char const *argv[]) {
                "\t                   from. (n.b. quote wildcards).\n"
                "\t-N <NMax>        : Maximum number of events to process.\n"
                "\t-o <out.root>    : File to write validation canvases to.\n"
+               "\t--shard <k/N>    : Only process the k-th (from 0) of N\n"
+               "\t                   equal slices of the input entries.\n"
+               "\t--entries <f:e>  : Only process input entries [f, e).\n"
+               "\t--checkpoint <n> : Commit output every n entries to\n"
+               "\t                   <out>.partNNNN.root files.\n"
+               "\t--resume         : Continue after the last committed\n"
+               "\t                   output of a previous run with the same\n"
+               "\t                   options.\n"
+               "\t                   Outputs can be combined with\n"
+               "\t                   MergeShardedTweaksNuSyst.\n"
+               "\t--queue-depth <n>: Read, calculate and write events on\n"
+               "\t                   separate threads, buffering up to n\n"
+               "\t                   events between each, {64}. 0 runs\n"
+               "\t                   every stage on the main thread.\n"
             << std::endl;
 }
 
@@ -294,6 +331,42 @@ void HandleOpts(int argc, char const *argv[]) {
       cliopts::NMax = str2T<size_t>(argv[++opt]);
     } else if (std::string(argv[opt]) == "-o") {
       cliopts::outputfile = argv[++opt];
+    } else if (std::string(argv[opt]) == "--shard") {
+      std::string arg = argv[++opt];
+      size_t slash = arg.find('/');
+      if (slash != std::string::npos) {
+        cliopts::shard_k = str2T<size_t>(arg.substr(0, slash));
+        cliopts::shard_N = str2T<size_t>(arg.substr(slash + 1));
+      }
+      if ((slash == std::string::npos) || !cliopts::shard_N ||
+          (cliopts::shard_k >= cliopts::shard_N)) {
+        std::cout << "[ERROR]: --shard expected an argument like k/N, with "
+                     "0 <= k < N, but found: "
+                  << std::quoted(arg) << std::endl;
+        SayUsage(argv);
+        exit(1);
+      }
+    } else if (std::string(argv[opt]) == "--entries") {
+      std::string arg = argv[++opt];
+      size_t colon = arg.find(':');
+      if (colon != std::string::npos) {
+        cliopts::first_entry = str2T<size_t>(arg.substr(0, colon));
+        cliopts::end_entry = str2T<size_t>(arg.substr(colon + 1));
+      }
+      if ((colon == std::string::npos) ||
+          (cliopts::first_entry > cliopts::end_entry)) {
+        std::cout << "[ERROR]: --entries expected an argument like "
+                     "first:end, with first <= end, but found: "
+                  << std::quoted(arg) << std::endl;
+        SayUsage(argv);
+        exit(1);
+      }
+    } else if (std::string(argv[opt]) == "--checkpoint") {
+      cliopts::CheckpointEvery = str2T<size_t>(argv[++opt]);
+    } else if (std::string(argv[opt]) == "--resume") {
+      cliopts::Resume = true;
+    } else if (std::string(argv[opt]) == "--queue-depth") {
+      cliopts::QueueDepth = str2T<size_t>(argv[++opt]);
     } else {
       std::cout << "[ERROR]: Unknown option: " << argv[opt] << std::endl;
       SayUsage(argv);
@@ -303,6 +376,22 @@ void HandleOpts(int argc, char const *argv[]) {
   }
 }
 
+/// Output file for the part-th committed slice of entries, the whole output
+/// goes to a single file if checkpointing is disabled.
+std::string GetOutputPartName(size_t part) {
+  if (!cliopts::CheckpointEvery) {
+    return cliopts::outputfile;
+  }
+  std::string stem = cliopts::outputfile;
+  if ((stem.size() > 5) && (stem.substr(stem.size() - 5) == ".root")) {
+    stem = stem.substr(0, stem.size() - 5);
+  }
+  std::stringstream ss("");
+  ss << stem << ".part" << std::setw(4) << std::setfill('0') << part
+     << ".root";
+  return ss.str();
+}
+
 #ifdef NO_ART
 typedef IGENIESystProvider_tool SystProv;
 #else
@@ -372,8 +461,11 @@ int main(int argc, char const *argv[]) {
     return 1;
   }
 
-#ifndef NO_ART
   fhicl::ParameterSet ps = ReadParameterSet(argv);
+  std::string config_md5 =
+      md5(ps.get<fhicl::ParameterSet>(cliopts::fhicl_key).to_compact_string());
+
+#ifndef NO_ART
   std::vector<std::unique_ptr<SystProv>> syst_providers;
   syst_providers =
       systtools::ConfigureISystProvidersFromParameterHeaders<SystProv>(
@@ -423,69 +515,251 @@ int main(int argc, char const *argv[]) {
     return 5;
   }
 
-  TweakSummaryTree tst(cliopts::outputfile.c_str());
-  tst.AddBranches(phh);
+  size_t NToRead = std::min(NEvs, cliopts::NMax);
+  size_t FirstEntry = std::min(cliopts::first_entry, NToRead);
+  size_t EndEntry = std::min(cliopts::end_entry, NToRead);
+  if (cliopts::shard_N) {
+    size_t NInRange = EndEntry - FirstEntry;
+    EndEntry = FirstEntry + (NInRange * (cliopts::shard_k + 1)) /
+                                cliopts::shard_N;
+    FirstEntry += (NInRange * cliopts::shard_k) / cliopts::shard_N;
+  }
+
+  size_t NextEntry = FirstEntry;
+  size_t NextPart = 0;
+  if (cliopts::Resume) {
+    while (!gSystem->AccessPathName(GetOutputPartName(NextPart).c_str())) {
+      std::string part_name = GetOutputPartName(NextPart);
+      TweakShardInfo part_info;
+      if (!part_info.Read(part_name)) {
+        std::cout << "[ERROR]: Failed to read shard_info from existing output "
+                  << std::quoted(part_name) << ", cannot resume."
+                  << std::endl;
+        return 6;
+      }
+      if ((part_info.config_md5 != config_md5) ||
+          (part_info.input != cliopts::genie_input) ||
+          (size_t(part_info.first_entry) != NextEntry) ||
+          (size_t(part_info.end_entry) > EndEntry)) {
+        std::cout << "[ERROR]: Existing output " << std::quoted(part_name)
+                  << " holds entries [" << part_info.first_entry << ", "
+                  << part_info.end_entry << ") of "
+                  << std::quoted(part_info.input)
+                  << " with configuration md5: "
+                  << std::quoted(part_info.config_md5)
+                  << ", which is inconsistent with resuming from entry "
+                  << NextEntry << " of [" << FirstEntry << ", " << EndEntry
+                  << ") of " << std::quoted(cliopts::genie_input)
+                  << " with configuration md5: " << std::quoted(config_md5)
+                  << "." << std::endl;
+        return 7;
+      }
+      NextEntry = part_info.end_entry;
+      NextPart++;
+      if (!cliopts::CheckpointEvery) {
+        break;
+      }
+    }
+    std::cout << "[INFO]: Resuming from entry " << NextEntry << " of ["
+              << FirstEntry << ", " << EndEntry << ") with " << NextPart
+              << " committed output files." << std::endl;
+  }
+
+  // Each part is written to a temporary file that is only renamed into place
+  // once it is complete, so a killed job leaves no partial output behind.
+  std::unique_ptr<TweakSummaryTree> tst;
+  std::string part_tmp_name;
+  size_t part_first = NextEntry;
+  auto OpenPart = [&](size_t first) {
+    part_first = first;
+    part_tmp_name = GetOutputPartName(NextPart) + ".tmp";
+    tst = std::make_unique<TweakSummaryTree>(part_tmp_name);
+    tst->AddBranches(phh);
+  };
+  auto CommitPart = [&](size_t end) {
+    TweakShardInfo part_info{config_md5, cliopts::genie_input,
+                             Long64_t(part_first), Long64_t(end)};
+    part_info.Write(tst->f);
+    tst.reset();
+    std::string part_name = GetOutputPartName(NextPart);
+    if (std::rename(part_tmp_name.c_str(), part_name.c_str())) {
+      throw failed_to_commit_output()
+          << "[ERROR]: Failed to rename " << std::quoted(part_tmp_name)
+          << " to " << std::quoted(part_name) << ".";
+    }
+    NextPart++;
+  };
 
   genie::Messenger::Instance()->SetPrioritiesFromXmlFile(
       "Messenger_whisper.xml");
 
-  size_t NToRead = std::min(NEvs, cliopts::NMax);
-  size_t NToShout = NToRead / 20;
+  size_t NToShout = (EndEntry - NextEntry) / 20;
   NToShout = NToShout ? NToShout : 1;
-  for (size_t ev_it = 0; ev_it < NToRead; ++ev_it) {
+
+  // Events pass through three stages: reading from the input TChain,
+  // calculating the responses, and writing to the output. With a non-zero
+  // queue depth, each stage runs on its own thread so that input
+  // decompression and output compression overlap with the calculation.
+  struct ReadEvent {
+    size_t entry;
+    std::unique_ptr<genie::EventRecord> owned;
+    genie::EventRecord const *ev;
+  };
+  struct CalculatedEvent {
+    EventSummary summary;
+    event_unit_response_w_cv_t resp;
+    /// Only set for events that are reported
+    std::string interaction;
+  };
+
+  auto ReadStage = [&](size_t ev_it, bool copy) {
     gevs->GetEntry(ev_it);
-    genie::EventRecord const &GenieGHep = *GenieNtpl->event;
+    ReadEvent rev{ev_it, nullptr, GenieNtpl->event};
+    if (copy) { // The next GetEntry overwrites GenieNtpl->event
+      rev.owned = std::make_unique<genie::EventRecord>(*GenieNtpl->event);
+      rev.ev = rev.owned.get();
+    }
+    return rev;
+  };
+
+  auto CalculateStage = [&](ReadEvent const &rev) {
+    genie::EventRecord const &GenieGHep = *rev.ev;
 
     genie::Target const &tgt = GenieGHep.Summary()->InitState().Tgt();
-    genie::GHepParticle *FSLep = GenieGHep.FinalStatePrimaryLepton();
-    genie::GHepParticle *ISLep = GenieGHep.Probe();
-    TLorentzVector FSLepP4 = *FSLep->P4();
-    TLorentzVector ISLepP4 = *ISLep->P4();
-    TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
-
-    tst.nu_pdg = ISLep->Pdg();
-    tst.e_nu_GeV = ISLepP4.E();
-    tst.tgt_A = tgt.A();
-    tst.tgt_Z = tgt.Z();
-    tst.is_cc = GenieGHep.Summary()->ProcInfo().IsWeakCC();
-    tst.is_qe = GenieGHep.Summary()->ProcInfo().IsQuasiElastic();
-    tst.is_mec = GenieGHep.Summary()->ProcInfo().IsMEC();
-    tst.mec_topology = -1;
-    if (tst.is_mec) {
-      tst.mec_topology = e2i(GetQELikeTarget(GenieGHep));
+    EventKinematics kin(GenieGHep);
+
+    CalculatedEvent cev;
+    EventSummary &es = cev.summary;
+    es.entry_index = rev.entry;
+    es.nu_pdg = kin.nu_pdg;
+    es.e_nu_GeV = kin.Enu_GeV;
+    es.tgt_A = tgt.A();
+    es.tgt_Z = tgt.Z();
+    es.is_cc = kin.is_cc;
+    es.is_qe = (kin.mode == simb_mode_copy::kQE);
+    es.is_mec = (kin.mode == simb_mode_copy::kMEC);
+    es.mec_topology = -1;
+    if (es.is_mec) {
+      es.mec_topology = kin.QELTargetIndeterminable()
+                            ? e2i(GetQELikeTarget(GenieGHep))
+                            : e2i(kin.QELTarget());
     }
-    tst.is_res = GenieGHep.Summary()->ProcInfo().IsResonant();
-    tst.res_channel = 0;
-    if (tst.is_res) {
-      tst.res_channel = SPPChannelFromGHep(GenieGHep);
+    es.is_res = (kin.mode == simb_mode_copy::kRes);
+    es.res_channel = 0;
+    if (es.is_res) {
+      es.res_channel = kin.SPPChannel();
     }
-    tst.is_dis = GenieGHep.Summary()->ProcInfo().IsDeepInelastic();
-    tst.W_GeV = GenieGHep.Summary()->Kine().W(true);
-    tst.Q2_GeV2 = -emTransfer.Mag2();
-    tst.q0_GeV = emTransfer[3];
-    tst.q3_GeV = emTransfer.Vect().Mag();
-
-    tst.EAvail_GeV = GetErecoil_MINERvA_LowRecoil(GenieGHep);
-
-    if (!(ev_it % NToShout)) {
-      std::cout << (ev_it ? "\r" : "") << "Event #" << ev_it << "/" << NToRead
-                << ", Interaction: " << GenieGHep.Summary()->AsString()
-                << std::flush;
+    es.is_dis = (kin.mode == simb_mode_copy::kDIS);
+    es.W_GeV = kin.W_GeV;
+    es.Q2_GeV2 = kin.Q2_GeV2;
+    es.q0_GeV = kin.q0_GeV;
+    es.q3_GeV = kin.q3_GeV;
+
+    es.EAvail_GeV = kin.EAvail_GeV();
+
+    if (!((rev.entry - FirstEntry) % NToShout)) {
+      cev.interaction = GenieGHep.Summary()->AsString();
     }
 
-    tst.Clear();
 #ifndef NO_ART
-    event_unit_response_w_cv_t resp;
     for (auto &sp : syst_providers) {
       systtools::ExtendEventUnitResponse(
-          resp, sp->GetEventVariationAndCVResponse(GenieGHep));
+          cev.resp, sp->GetEventVariationAndCVResponse(GenieGHep, kin));
     }
 #else
-    event_unit_response_w_cv_t resp =
-        phh.GetEventVariationAndCVResponse(GenieGHep);
+    cev.resp = phh.GetEventVariationAndCVResponse(GenieGHep, kin);
 #endif
-    tst.Add(resp);
-    tst.Fill();
+    return cev;
+  };
+
+  auto WriteStage = [&](CalculatedEvent const &cev) {
+    size_t ev_it = cev.summary.entry_index;
+    if (!tst) {
+      OpenPart(ev_it);
+    }
+
+    if (cev.interaction.size()) {
+      std::cout << "\r" << "Event #" << ev_it << "/" << EndEntry
+                << ", Interaction: " << cev.interaction << std::flush;
+    }
+
+    tst->Clear();
+    static_cast<EventSummary &>(*tst) = cev.summary;
+    tst->Add(cev.resp);
+    tst->Fill();
+
+    if (cliopts::CheckpointEvery &&
+        ((ev_it + 1 - part_first) == cliopts::CheckpointEvery)) {
+      CommitPart(ev_it + 1);
+    }
+  };
+
+  if (!cliopts::QueueDepth) {
+    for (size_t ev_it = NextEntry; ev_it < EndEntry; ++ev_it) {
+      WriteStage(CalculateStage(ReadStage(ev_it, false)));
+    }
+  } else {
+    ROOT::EnableThreadSafety();
+
+    BoundedSPSCQueue<ReadEvent> read_queue(cliopts::QueueDepth);
+    BoundedSPSCQueue<CalculatedEvent> calculated_queue(cliopts::QueueDepth);
+
+    // A failing stage closes its queues, which stops the other stages, and
+    // the first error is rethrown once all have finished. The open part is
+    // then left uncommitted.
+    std::exception_ptr read_error, calculate_error, write_error;
+    std::thread reader([&]() {
+      try {
+        for (size_t ev_it = NextEntry; ev_it < EndEntry; ++ev_it) {
+          if (!read_queue.Push(ReadStage(ev_it, true))) {
+            break;
+          }
+        }
+      } catch (...) {
+        read_error = std::current_exception();
+      }
+      read_queue.Close();
+    });
+    std::thread calculator([&]() {
+      try {
+        ReadEvent rev;
+        while (read_queue.Pop(rev)) {
+          if (!calculated_queue.Push(CalculateStage(rev))) {
+            break;
+          }
+        }
+      } catch (...) {
+        calculate_error = std::current_exception();
+      }
+      read_queue.Close();
+      calculated_queue.Close();
+    });
+
+    try {
+      CalculatedEvent cev;
+      while (calculated_queue.Pop(cev)) {
+        WriteStage(cev);
+      }
+    } catch (...) {
+      write_error = std::current_exception();
+    }
+    calculated_queue.Close();
+
+    reader.join();
+    calculator.join();
+    for (std::exception_ptr const &err :
+         {read_error, calculate_error, write_error}) {
+      if (err) {
+        std::rethrow_exception(err);
+      }
+    }
+  }
+
+  if (tst) {
+    CommitPart(EndEntry);
+  } else if (!NextPart) { // Empty range, still leave an output behind.
+    OpenPart(NextEntry);
+    CommitPart(NextEntry);
   }
   std::cout << std::endl;
 }
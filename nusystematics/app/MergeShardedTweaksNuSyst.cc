@@ -0,0 +1,211 @@
+#include "nusystematics/app/TweakShardInfo.hh"
+
+#include "TChain.h"
+#include "TFile.h"
+#include "TObjString.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace nusyst;
+
+namespace cliopts {
+std::string outputfile = "";
+std::vector<std::string> inputfiles;
+} // namespace cliopts
+
+void SayUsage(char const *argv[]) {
+  std::cout << "[USAGE]: " << argv[0] << "\n"
+            << "\t-o <output.root>  : File to write merged tweaks to.\n"
+            << "\t<input.root> ...  : DumpConfiguredTweaksNuSyst outputs to "
+               "merge, they must\n"
+               "\t                    cover a contiguous range of input "
+               "entries with the same\n"
+               "\t                    configuration.\n"
+            << std::endl;
+}
+
+void HandleOpts(int argc, char const *argv[]) {
+  int opt = 1;
+  while (opt < argc) {
+    if ((std::string(argv[opt]) == "-?") ||
+        (std::string(argv[opt]) == "--help")) {
+      SayUsage(argv);
+      exit(0);
+    } else if (std::string(argv[opt]) == "-o") {
+      cliopts::outputfile = argv[++opt];
+    } else {
+      cliopts::inputfiles.push_back(argv[opt]);
+    }
+    opt++;
+  }
+}
+
+struct TweakMetadata {
+  std::string name;
+  std::vector<double> tweakvalues;
+
+  bool operator==(TweakMetadata const &other) const {
+    return (name == other.name) && (tweakvalues == other.tweakvalues);
+  }
+  bool operator!=(TweakMetadata const &other) const {
+    return !(*this == other);
+  }
+};
+
+/// Returns false if f holds no readable tweak_metadata tree.
+bool ReadTweakMetadata(TFile *f, std::vector<TweakMetadata> &md) {
+  TTree *m = f->Get<TTree>("tweak_metadata");
+  if (!m) {
+    return false;
+  }
+  TObjString *name = nullptr;
+  int ntweaks = 0;
+  std::vector<double> tweakvalues(
+      std::max(1, int(m->GetMaximum("ntweaks"))));
+  if ((m->SetBranchAddress("name", &name) != TTree::kMatch) ||
+      (m->SetBranchAddress("ntweaks", &ntweaks) != TTree::kMatch) ||
+      (m->SetBranchAddress("tweakvalues", tweakvalues.data()) !=
+       TTree::kMatch)) {
+    return false;
+  }
+  md.clear();
+  for (Long64_t i = 0; i < m->GetEntries(); ++i) {
+    m->GetEntry(i);
+    md.push_back({name->GetString().Data(),
+                  std::vector<double>(tweakvalues.begin(),
+                                      tweakvalues.begin() + ntweaks)});
+  }
+  m->ResetBranchAddresses();
+  delete name;
+  return true;
+}
+
+struct InputShard {
+  std::string fname;
+  TweakShardInfo info;
+  Long64_t NEntries;
+  std::vector<TweakMetadata> md;
+};
+
+int main(int argc, char const *argv[]) {
+  HandleOpts(argc, argv);
+  if (!cliopts::outputfile.size()) {
+    std::cout << "[ERROR]: Expected to be passed a -o option." << std::endl;
+    SayUsage(argv);
+    return 1;
+  }
+  if (!cliopts::inputfiles.size()) {
+    std::cout << "[ERROR]: Expected to be passed at least one input file."
+              << std::endl;
+    SayUsage(argv);
+    return 1;
+  }
+
+  std::vector<InputShard> shards;
+  for (std::string const &fname : cliopts::inputfiles) {
+    TFile f(fname.c_str(), "READ");
+    if (f.IsZombie()) {
+      std::cout << "[ERROR]: Failed to open " << std::quoted(fname) << "."
+                << std::endl;
+      return 2;
+    }
+    InputShard shard;
+    shard.fname = fname;
+    TTree *t = f.Get<TTree>("events");
+    if (!t || !shard.info.Read(&f) || !ReadTweakMetadata(&f, shard.md)) {
+      std::cout << "[ERROR]: Input " << std::quoted(fname)
+                << " is not a DumpConfiguredTweaksNuSyst output with "
+                   "shard_info."
+                << std::endl;
+      return 2;
+    }
+    shard.NEntries = t->GetEntries();
+    shards.push_back(std::move(shard));
+  }
+
+  std::stable_sort(shards.begin(), shards.end(),
+                   [](InputShard const &l, InputShard const &r) {
+                     return l.info.first_entry < r.info.first_entry;
+                   });
+
+  for (size_t s_it = 0; s_it < shards.size(); ++s_it) {
+    InputShard const &shard = shards[s_it];
+    if (shard.NEntries != (shard.info.end_entry - shard.info.first_entry)) {
+      std::cout << "[ERROR]: Input " << std::quoted(shard.fname)
+                << " claims to hold entries [" << shard.info.first_entry
+                << ", " << shard.info.end_entry << "), but contains "
+                << shard.NEntries << " events." << std::endl;
+      return 3;
+    }
+    if (!s_it) {
+      continue;
+    }
+    InputShard const &first = shards.front();
+    InputShard const &prev = shards[s_it - 1];
+    if ((shard.info.config_md5 != first.info.config_md5) ||
+        (shard.info.input != first.info.input) || (shard.md != first.md)) {
+      std::cout << "[ERROR]: Input " << std::quoted(shard.fname)
+                << " was produced from " << std::quoted(shard.info.input)
+                << " with configuration md5: "
+                << std::quoted(shard.info.config_md5) << ", but input "
+                << std::quoted(first.fname) << " was produced from "
+                << std::quoted(first.info.input)
+                << " with configuration md5: "
+                << std::quoted(first.info.config_md5)
+                << ", or their tweak_metadata differ." << std::endl;
+      return 4;
+    }
+    if (shard.info.first_entry != prev.info.end_entry) {
+      std::cout << "[ERROR]: Input " << std::quoted(prev.fname)
+                << " holds entries [" << prev.info.first_entry << ", "
+                << prev.info.end_entry << ") and input "
+                << std::quoted(shard.fname) << " holds entries ["
+                << shard.info.first_entry << ", " << shard.info.end_entry
+                << "), which "
+                << ((shard.info.first_entry < prev.info.end_entry)
+                        ? "overlap."
+                        : "leave a gap.")
+                << std::endl;
+      return 5;
+    }
+  }
+
+  TChain events("events");
+  for (InputShard const &shard : shards) {
+    events.Add(shard.fname.c_str());
+  }
+
+  TFile fout(cliopts::outputfile.c_str(), "RECREATE");
+  if (fout.IsZombie()) {
+    std::cout << "[ERROR]: Failed to open " << std::quoted(cliopts::outputfile)
+              << " for writing." << std::endl;
+    return 6;
+  }
+  fout.cd();
+  TTree *merged_events = events.CloneTree(-1, "fast");
+  merged_events->SetDirectory(&fout);
+
+  TFile fmeta(shards.front().fname.c_str(), "READ");
+  fout.cd();
+  TTree *merged_meta = fmeta.Get<TTree>("tweak_metadata")->CloneTree(-1);
+  merged_meta->SetDirectory(&fout);
+
+  TweakShardInfo merged_info{shards.front().info.config_md5,
+                             shards.front().info.input,
+                             shards.front().info.first_entry,
+                             shards.back().info.end_entry};
+  merged_info.Write(&fout);
+
+  fout.Write();
+  fout.Close();
+
+  std::cout << "[INFO]: Merged " << shards.size()
+            << " inputs covering entries [" << merged_info.first_entry << ", "
+            << merged_info.end_entry << ") into "
+            << std::quoted(cliopts::outputfile) << "." << std::endl;
+}
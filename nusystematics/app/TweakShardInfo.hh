@@ -0,0 +1,77 @@
+#ifndef nusystematics_APP_TWEAKSHARDINFO_SEEN
+#define nusystematics_APP_TWEAKSHARDINFO_SEEN
+
+#include "TFile.h"
+#include "TObjString.h"
+#include "TTree.h"
+
+#include <string>
+
+namespace nusyst {
+
+/// Describes the input entries whose tweaks are held in one
+/// DumpConfiguredTweaksNuSyst output file, stored in its shard_info tree.
+struct TweakShardInfo {
+  std::string config_md5;
+  std::string input;
+  /// Input TChain entries [first_entry, end_entry)
+  Long64_t first_entry;
+  Long64_t end_entry;
+
+  /// Adds a shard_info tree to f, which is written with f.
+  void Write(TFile *f) const {
+    f->cd();
+    TTree *s = new TTree("shard_info", "");
+    s->SetDirectory(f);
+
+    TObjString md5_str(config_md5.c_str());
+    TObjString input_str(input.c_str());
+    TObjString *md5_ptr = &md5_str;
+    TObjString *input_ptr = &input_str;
+    Long64_t first = first_entry;
+    Long64_t end = end_entry;
+
+    s->Branch("config_md5", &md5_ptr);
+    s->Branch("input", &input_ptr);
+    s->Branch("first_entry", &first, "first_entry/L");
+    s->Branch("end_entry", &end, "end_entry/L");
+    s->Fill();
+    // Written along with the rest of f
+    s->ResetBranchAddresses();
+  }
+
+  /// Returns false if f holds no readable shard_info tree.
+  bool Read(TFile *f) {
+    TTree *s = f->Get<TTree>("shard_info");
+    if (!s || (s->GetEntries() != 1)) {
+      return false;
+    }
+    TObjString *md5_ptr = nullptr;
+    TObjString *input_ptr = nullptr;
+    if ((s->SetBranchAddress("config_md5", &md5_ptr) != TTree::kMatch) ||
+        (s->SetBranchAddress("input", &input_ptr) != TTree::kMatch) ||
+        (s->SetBranchAddress("first_entry", &first_entry) != TTree::kMatch) ||
+        (s->SetBranchAddress("end_entry", &end_entry) != TTree::kMatch)) {
+      return false;
+    }
+    s->GetEntry(0);
+    config_md5 = md5_ptr->GetString().Data();
+    input = input_ptr->GetString().Data();
+    s->ResetBranchAddresses();
+    delete md5_ptr;
+    delete input_ptr;
+    return true;
+  }
+
+  bool Read(std::string const &fname) {
+    TFile f(fname.c_str(), "READ");
+    if (f.IsZombie()) {
+      return false;
+    }
+    return Read(&f);
+  }
+};
+
+} // namespace nusyst
+
+#endif
@@ -0,0 +1,86 @@
+#include "nusystematics/artless/response_helper.hh"
+
+#include "nusystematics/utility/TemplateBank.hh"
+
+#include <iostream>
+#include <string>
+
+using namespace nusyst;
+
+namespace cliopts {
+std::string fclname = "";
+std::string outputfile = "";
+} // namespace cliopts
+
+void SayUsage(char const *argv[]) {
+  std::cout << "[USAGE]: " << argv[0] << "\n" << std::endl;
+  std::cout << "\t-?|--help         : Show this message.\n"
+               "\t-c <config.fcl>   : fhicl file to read, every template "
+               "loaded by the\n"
+               "\t                    configured providers is written to the "
+               "bank.\n"
+               "\t-o <output.bank>  : Template bank file to write."
+            << std::endl;
+}
+
+void HandleOpts(int argc, char const *argv[]) {
+  if (argc == 1) {
+    SayUsage(argv);
+    exit(1);
+  }
+  int opt = 1;
+  while (opt < argc) {
+    if ((std::string(argv[opt]) == "-?") ||
+        (std::string(argv[opt]) == "--help")) {
+      SayUsage(argv);
+      exit(0);
+    } else if (std::string(argv[opt]) == "-c") {
+      cliopts::fclname = argv[++opt];
+    } else if (std::string(argv[opt]) == "-o") {
+      cliopts::outputfile = argv[++opt];
+    } else {
+      std::cout << "[ERROR]: Unknown option: " << argv[opt] << std::endl;
+      SayUsage(argv);
+      exit(1);
+    }
+    opt++;
+  }
+}
+
+int main(int argc, char const *argv[]) {
+
+  HandleOpts(argc, argv);
+
+  if (!cliopts::fclname.size() || !cliopts::outputfile.size()) {
+    std::cout << "[ERROR]: Both -c and -o must be passed." << std::endl;
+    SayUsage(argv);
+    return 1;
+  }
+
+  // Providers read their templates from the input manifests while configuring,
+  // with the writer set each one is recorded as it is loaded.
+  TemplateBankWriter writer;
+  TemplateBankWriter::Recording() = &writer;
+  {
+    response_helper nrh(cliopts::fclname);
+    std::cout << "[INFO]: Loaded parameters: " << std::endl
+              << nrh.GetHeaderInfo() << std::endl;
+  }
+  TemplateBankWriter::Recording() = nullptr;
+
+  if (!writer.GetNTemplates()) {
+    std::cout << "[ERROR]: No templates were loaded by the providers "
+                 "configured in "
+              << cliopts::fclname << "." << std::endl;
+    return 2;
+  }
+
+  writer.Write(cliopts::outputfile);
+
+  // Re-map the written file to check it before it is used.
+  std::shared_ptr<TemplateBank const> bank =
+      TemplateBank::Open(cliopts::outputfile);
+  std::cout << "[INFO]: Wrote " << bank->GetNTemplates()
+            << " templates to template bank " << cliopts::outputfile
+            << std::endl;
+}
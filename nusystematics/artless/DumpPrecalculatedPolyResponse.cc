@@ -1,5 +1,6 @@
 #include "nusystematics/artless/response_helper.hh"
 
+#include "nusystematics/utility/BoundedSPSCQueue.hh"
 #include "nusystematics/utility/GENIEUtils.hh"
 #include "nusystematics/utility/enumclass2int.hh"
 
@@ -15,9 +16,13 @@
 #include "string_parsers/to_string.hxx"
 
 #include "TFile.h"
+#include "TROOT.h"
 #include "TTree.h"
 
+#include <exception>
 #include <iostream>
+#include <memory>
+#include <thread>
 
 using namespace fhicl;
 using namespace systtools;
@@ -28,12 +33,21 @@ std::string fclname = "";
 std::string inputfile = "";
 std::string outputfile = "";
 size_t NMax = std::numeric_limits<size_t>::max();
+size_t NThreads = 1;
 
 } // namespace cliopts
 
 constexpr size_t Order = 5;
 constexpr size_t NCoeffs = Order + 1;
 
+/// A contiguous run of input entries, passed from the reader to a worker and
+/// then from that worker to the writer.
+struct EventBatch {
+  std::vector<std::unique_ptr<genie::EventRecord>> events;
+  batch_response_t responses;
+  std::exception_ptr error;
+};
+
 void SayUsage(char const *argv[]) {
   std::cout << "[USAGE]: " << argv[0] << "\n" << std::endl;
   std::cout << "\t-?|--help         : Show this message.\n"
@@ -41,7 +55,9 @@ void SayUsage(char const *argv[]) {
                "\t-i <ghep.root>    : GENIE event file to read.\n"
                "\t-o <output.rooot> : Response file to write.\n"
                "\t-n <NMax>         : Only calculate splines for the first "
-               "NMax events."
+               "NMax events.\n"
+               "\t-j <nthreads>     : Calculate responses on nthreads worker "
+               "threads, output is written in input order."
             << std::endl;
 }
 
@@ -64,6 +80,8 @@ void HandleOpts(int argc, char const *argv[]) {
       cliopts::outputfile = argv[++opt];
     } else if (std::string(argv[opt]) == "-n") {
       cliopts::NMax = string_parsers::str2T<size_t>(argv[++opt]);
+    } else if (std::string(argv[opt]) == "-j") {
+      cliopts::NThreads = string_parsers::str2T<size_t>(argv[++opt]);
     } else {
       std::cout << "[ERROR]: Unknown option: " << argv[opt] << std::endl;
       SayUsage(argv);
@@ -77,6 +95,11 @@ int main(int argc, char const *argv[]) {
 
   HandleOpts(argc, argv);
 
+  // Must precede any ROOT I/O that may later be shared with worker threads.
+  if (cliopts::NThreads > 1) {
+    ROOT::EnableThreadSafety();
+  }
+
   response_helper nrh(cliopts::fclname);
   std::cout << "[INFO]: Loaded parameters: " << std::endl
             << nrh.GetHeaderInfo() << std::endl;
@@ -116,15 +139,126 @@ int main(int argc, char const *argv[]) {
 
   size_t NToRead = std::min(NEvs, cliopts::NMax);
   size_t NToShout = NToRead / 100;
-  for (size_t ev_it = 0; ev_it < NToRead; ++ev_it) {
-    gevs->GetEntry(ev_it);
-    if (NToShout && !(ev_it % NToShout)) {
-      std::cout << "Event #" << ev_it
-                << ", Interaction: " << GenieNtpl->event->Summary()->AsString()
-                << std::endl;
+
+  if (cliopts::NThreads < 2) {
+    for (size_t ev_it = 0; ev_it < NToRead; ++ev_it) {
+      gevs->GetEntry(ev_it);
+      if (NToShout && !(ev_it % NToShout)) {
+        std::cout << "Event #" << ev_it << ", Interaction: "
+                  << GenieNtpl->event->Summary()->AsString() << std::endl;
+      }
+
+      prr->AddEventResponses(nrh.GetEventResponses(*GenieNtpl->event));
+    }
+  } else {
+    size_t const NWorkers = cliopts::NThreads;
+
+    // Each worker owns a full set of providers, the first uses nrh.
+    std::vector<std::unique_ptr<response_helper>> worker_helpers;
+    for (size_t th_it = 1; th_it < NWorkers; ++th_it) {
+      worker_helpers.push_back(nrh.Clone());
+    }
+
+    // A reader thread copies batches of events off the input tree and deals
+    // them out to the workers in turn, this thread collects the results in
+    // the same order so that the output is written in input order. Each
+    // queue has a single producer and a single consumer.
+    size_t const BatchSize = 256;
+    size_t const QueueDepth = 2;
+    std::vector<std::unique_ptr<BoundedSPSCQueue<EventBatch>>> to_workers;
+    std::vector<std::unique_ptr<BoundedSPSCQueue<EventBatch>>> from_workers;
+    for (size_t th_it = 0; th_it < NWorkers; ++th_it) {
+      to_workers.push_back(
+          std::make_unique<BoundedSPSCQueue<EventBatch>>(QueueDepth));
+      from_workers.push_back(
+          std::make_unique<BoundedSPSCQueue<EventBatch>>(QueueDepth));
     }
 
-    prr->AddEventResponses(nrh.GetEventResponses(*GenieNtpl->event));
+    std::exception_ptr reader_error;
+    std::thread reader([&]() {
+      try {
+        size_t batch_it = 0;
+        for (size_t batch_start = 0; batch_start < NToRead;
+             batch_start += BatchSize, ++batch_it) {
+          size_t batch_end = std::min(batch_start + BatchSize, NToRead);
+          EventBatch batch;
+          for (size_t ev_it = batch_start; ev_it < batch_end; ++ev_it) {
+            gevs->GetEntry(ev_it);
+            if (NToShout && !(ev_it % NToShout)) {
+              std::cout << "Event #" << ev_it << ", Interaction: "
+                        << GenieNtpl->event->Summary()->AsString()
+                        << std::endl;
+            }
+            batch.events.push_back(
+                std::make_unique<genie::EventRecord>(*GenieNtpl->event));
+          }
+          if (!to_workers[batch_it % NWorkers]->Push(std::move(batch))) {
+            break; // The writer has abandoned the output.
+          }
+        }
+      } catch (...) {
+        reader_error = std::current_exception();
+      }
+      for (auto &q : to_workers) {
+        q->Close();
+      }
+    });
+
+    std::vector<std::thread> workers;
+    for (size_t th_it = 0; th_it < NWorkers; ++th_it) {
+      response_helper *rh = th_it ? worker_helpers[th_it - 1].get() : &nrh;
+      workers.emplace_back([&, th_it, rh]() {
+        BoundedSPSCQueue<EventBatch> &in = *to_workers[th_it];
+        BoundedSPSCQueue<EventBatch> &out = *from_workers[th_it];
+        EventBatch batch;
+        while (in.Pop(batch)) {
+          try {
+            std::vector<genie::EventRecord const *> event_ptrs;
+            for (auto const &ev : batch.events) {
+              event_ptrs.push_back(ev.get());
+            }
+            rh->GetEventResponses(GHepRecordSpan(event_ptrs),
+                                  batch.responses);
+          } catch (...) {
+            batch.error = std::current_exception();
+          }
+          batch.events.clear();
+          if (!out.Push(std::move(batch))) {
+            break;
+          }
+        }
+        out.Close();
+      });
+    }
+
+    std::exception_ptr worker_error;
+    EventBatch batch;
+    for (size_t batch_it = 0;
+         from_workers[batch_it % NWorkers]->Pop(batch); ++batch_it) {
+      if (batch.error) {
+        worker_error = batch.error;
+        break;
+      }
+      for (event_unit_response_t &resp : batch.responses) {
+        prr->AddEventResponses(std::move(resp));
+      }
+    }
+
+    // Unblocks the reader and workers if the stream was abandoned early.
+    for (size_t th_it = 0; th_it < NWorkers; ++th_it) {
+      to_workers[th_it]->Close();
+      from_workers[th_it]->Close();
+    }
+    reader.join();
+    for (std::thread &w : workers) {
+      w.join();
+    }
+    if (reader_error) {
+      std::rethrow_exception(reader_error);
+    }
+    if (worker_error) {
+      std::rethrow_exception(worker_error);
+    }
   }
   of->Write();
   of->Close();
@@ -85,6 +85,8 @@ int main(int argc, char const *argv[]) {
   size_t NToRead = std::min(NEvs, NMax);
   size_t NToShout = NToRead / 20;
   NToShout = NToShout ? NToShout : 1;
+  // Re-used for every event, so that responses are written in place.
+  ResponseBuffer resp_buf = nrh.MakeResponseBuffer();
   for (size_t ev_it = 0; ev_it < NToRead; ++ev_it) {
     gevs->GetEntry(ev_it);
     genie::EventRecord *GenieGHep = GenieNtpl->event;
@@ -94,8 +96,10 @@ int main(int argc, char const *argv[]) {
                 << std::flush;
     }
 
-    event_unit_response_t resp = nrh.GetEventResponses(*GenieGHep);
+    nrh.GetEventResponses(*GenieGHep, resp_buf);
     if (verbose) {
+      event_unit_response_t resp;
+      resp_buf.AppendTo(resp);
       std::cout << "[INFO]: Response =  " << std::endl
                 << nrh.GetEventResponseInfo(resp) << std::endl;
     }
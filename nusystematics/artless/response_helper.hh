@@ -40,6 +40,29 @@ private:
   std::string config_file;
   std::vector<std::unique_ptr<IGENIESystProvider_tool>> syst_providers;
 
+  /// Not inherited by copies, as the providers' clones need not inherit the
+  /// throw bank.
+  size_t NThrowBankUniverses = 0;
+
+  /// Cached per provider so that providers can be skipped for events outside
+  /// of their declared applicability.
+  struct provider_applicability {
+    InteractionMask mask;
+    systtools::event_unit_response_t unmatched;
+    systtools::event_unit_response_w_cv_t unmatched_w_cv;
+  };
+  std::vector<provider_applicability> applicability;
+
+  void CacheApplicability() {
+    applicability.clear();
+    for (auto &sp : syst_providers) {
+      systtools::event_unit_response_t unmatched =
+          sp->GetUnmatchedEventResponse();
+      applicability.push_back({sp->GetApplicability(), unmatched,
+                               sp->BuildVariationAndCVResponse(unmatched)});
+    }
+  }
+
   void LoadProvidersAndHeaders(fhicl::ParameterSet const &ps) {
     syst_providers = systtools::ConfigureISystProvidersFromParameterHeaders<
         IGENIESystProvider_tool>(ps, make_instance);
@@ -59,6 +82,16 @@ private:
     }
 
     SetHeaders(configuredParameterHeaders);
+    CacheApplicability();
+  }
+
+  response_helper(response_helper const &other)
+      : systtools::ParamHeaderHelper(other), NEvsProcessed(0),
+        ProfilerRate(other.ProfilerRate), config_file(other.config_file),
+        applicability(other.applicability) {
+    for (auto const &sp : other.syst_providers) {
+      syst_providers.push_back(sp->Clone());
+    }
   }
 
 public:
@@ -77,12 +110,25 @@ public:
     ProfilerRate = ps.get<size_t>("ProfileRate", 0);
   }
 
+  /// Returns an independent copy holding clones of the configured systematic
+  /// providers, for use on another thread.
+  std::unique_ptr<response_helper> Clone() const {
+    return std::unique_ptr<response_helper>(new response_helper(*this));
+  }
+
   systtools::event_unit_response_t
   GetEventResponses(genie::EventRecord const &GenieGHep) {
     systtools::event_unit_response_t response;
-    for (auto &sp : syst_providers) {
+    EventKinematics kin(GenieGHep);
+    for (size_t sp_it = 0; sp_it < syst_providers.size(); ++sp_it) {
+      if (!applicability[sp_it].mask.Matches(kin)) {
+        for (auto const &er : applicability[sp_it].unmatched) {
+          response.push_back(er);
+        }
+        continue;
+      }
       systtools::event_unit_response_t prov_response =
-          sp->GetEventResponse(GenieGHep);
+          syst_providers[sp_it]->GetEventResponse(GenieGHep, kin);
       for (auto &&er : prov_response) {
         response.push_back(std::move(er));
       }
@@ -90,6 +136,79 @@ public:
     return response;
   }
 
+  /// Returns a buffer with a slot for each response parameter of every
+  /// configured provider, for use with GetEventResponses(ev, ResponseBuffer&).
+  ResponseBuffer MakeResponseBuffer() const {
+    ResponseBuffer buf;
+    for (auto const &sp : syst_providers) {
+      buf.AddParameters(sp->GetSystMetaData());
+    }
+    return buf;
+  }
+
+  /// Writes the responses of all configured providers into buf, which is
+  /// cleared first. Re-using one buffer across events avoids per-event
+  /// allocation.
+  void GetEventResponses(genie::EventRecord const &GenieGHep,
+                         ResponseBuffer &buf) {
+    buf.Clear();
+    EventKinematics kin(GenieGHep);
+    for (size_t sp_it = 0; sp_it < syst_providers.size(); ++sp_it) {
+      if (!applicability[sp_it].mask.Matches(kin)) {
+        for (auto const &er : applicability[sp_it].unmatched) {
+          buf.Fill(er.pid, er.responses);
+        }
+        continue;
+      }
+      syst_providers[sp_it]->FillEventResponse(GenieGHep, kin, buf);
+    }
+  }
+
+  /// Fills one event_unit_response_t per record in events, each provider that
+  /// applies to all interactions is handed the whole batch.
+  void GetEventResponses(GHepRecordSpan events, batch_response_t &responses) {
+    std::vector<EventKinematics> kins;
+    if (!events.HasKinematics()) {
+      kins.reserve(events.size);
+      for (size_t ev_it = 0; ev_it < events.size; ++ev_it) {
+        kins.emplace_back(events[ev_it]);
+      }
+      events.kinematics = kins.data();
+    }
+
+    responses.clear();
+    responses.resize(events.size);
+    batch_response_t prov_responses;
+    for (size_t sp_it = 0; sp_it < syst_providers.size(); ++sp_it) {
+      std::unique_ptr<IGENIESystProvider_tool> const &sp =
+          syst_providers[sp_it];
+      provider_applicability const &app = applicability[sp_it];
+
+      if (!app.mask.IsAll()) {
+        for (size_t ev_it = 0; ev_it < events.size; ++ev_it) {
+          if (!app.mask.Matches(events.Kinematics(ev_it))) {
+            for (auto const &er : app.unmatched) {
+              responses[ev_it].push_back(er);
+            }
+            continue;
+          }
+          for (auto &&er :
+               sp->GetEventResponse(events[ev_it], events.Kinematics(ev_it))) {
+            responses[ev_it].push_back(std::move(er));
+          }
+        }
+        continue;
+      }
+
+      sp->GetEventResponses(events, prov_responses);
+      for (size_t ev_it = 0; ev_it < events.size; ++ev_it) {
+        for (auto &&er : prov_responses[ev_it]) {
+          responses[ev_it].push_back(std::move(er));
+        }
+      }
+    }
+  }
+
   systtools::event_unit_response_t
   GetEventResponses(genie::EventRecord const &GenieGHep,
                     systtools::paramId_t i) {
@@ -106,21 +225,35 @@ public:
 
   systtools::event_unit_response_w_cv_t
   GetEventVariationAndCVResponse(genie::EventRecord const &GenieGHep) {
+    return GetEventVariationAndCVResponse(GenieGHep,
+                                          EventKinematics(GenieGHep));
+  }
+
+  systtools::event_unit_response_w_cv_t
+  GetEventVariationAndCVResponse(genie::EventRecord const &GenieGHep,
+                                 EventKinematics const &kin) {
     systtools::event_unit_response_w_cv_t response;
 
-    simb_mode_copy mode = GetSimbMode(GenieGHep);
+    simb_mode_copy mode = kin.mode;
 
     for (size_t sp_it = 0; sp_it < syst_providers.size(); ++sp_it) {
       std::unique_ptr<IGENIESystProvider_tool> const &sp =
           syst_providers[sp_it];
 
+      if (!applicability[sp_it].mask.Matches(kin)) {
+        for (auto const &er : applicability[sp_it].unmatched_w_cv) {
+          response.push_back(er);
+        }
+        continue;
+      }
+
       std::chrono::high_resolution_clock::time_point start;
       if (ProfilerRate) {
         start = std::chrono::high_resolution_clock::now();
       }
 
       systtools::event_unit_response_w_cv_t prov_response =
-          sp->GetEventVariationAndCVResponse(GenieGHep);
+          sp->GetEventVariationAndCVResponse(GenieGHep, kin);
 
       if (ProfilerRate && prov_response.size()) {
         auto end = std::chrono::high_resolution_clock::now();
@@ -181,6 +314,47 @@ public:
     }
     return weight;
   }
+
+  /// Configures every provider for a single throw, which is then applied to
+  /// events with CalcWeight.
+  void SetThrow(systtools::param_value_list_t const &vals) {
+    for (auto &sp : syst_providers) {
+      sp->SetThrow(vals);
+    }
+  }
+
+  double CalcWeight(genie::EventRecord const &GenieGHep) {
+    EventKinematics kin(GenieGHep);
+    double weight = 1;
+    for (auto &sp : syst_providers) {
+      weight *= sp->CalcWeight(GenieGHep, kin);
+    }
+    return weight;
+  }
+
+  /// Configures every provider for a bank of throws, which are then applied
+  /// to events together with CalcThrowBankWeights.
+  void
+  SetThrowBank(std::vector<systtools::param_value_list_t> const &universes) {
+    NThrowBankUniverses = universes.size();
+    for (auto &sp : syst_providers) {
+      sp->SetThrowBank(universes);
+    }
+  }
+
+  /// The weight of the event in each universe of the last SetThrowBank.
+  std::vector<double> CalcThrowBankWeights(genie::EventRecord const &GenieGHep) {
+    EventKinematics kin(GenieGHep);
+    std::vector<double> weights(NThrowBankUniverses, 1);
+    std::vector<double> sp_weights;
+    for (auto &sp : syst_providers) {
+      sp->CalcThrowBankWeights(GenieGHep, kin, sp_weights);
+      for (size_t u_it = 0; u_it < weights.size(); ++u_it) {
+        weights[u_it] *= sp_weights[u_it];
+      }
+    }
+    return weights;
+  }
 }; // namespace nusyst
 } // namespace nusyst
 
@@ -3,6 +3,11 @@
 
 #include "systematicstools/interface/ISystProviderTool.hh"
 
+#include "nusystematics/interface/ResponseBuffer.hh"
+
+#include "nusystematics/utility/EventKinematics.hh"
+#include "nusystematics/utility/InteractionMask.hh"
+
 #ifndef NO_ART
 #include "nusimdata/SimulationBase/GTruth.h"
 #include "nusimdata/SimulationBase/MCTruth.h"
@@ -15,8 +20,42 @@
 // GENIE
 #include "Framework/EventGen/EventRecord.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
 namespace nusyst {
 
+/// Non-owning view of a contiguous batch of GHep records, optionally with
+/// their precalculated EventKinematics.
+struct GHepRecordSpan {
+  genie::EventRecord const *const *data;
+  size_t size;
+  EventKinematics const *kinematics;
+
+  GHepRecordSpan(genie::EventRecord const *const *d, size_t n,
+                 EventKinematics const *k = nullptr)
+      : data(d), size(n), kinematics(k) {}
+  GHepRecordSpan(std::vector<genie::EventRecord const *> const &evs)
+      : data(evs.data()), size(evs.size()), kinematics(nullptr) {}
+  GHepRecordSpan(std::vector<genie::EventRecord const *> const &evs,
+                 std::vector<EventKinematics> const &kins)
+      : data(evs.data()), size(evs.size()), kinematics(kins.data()) {}
+
+  genie::EventRecord const &operator[](size_t i) const { return *data[i]; }
+  bool HasKinematics() const { return kinematics; }
+  EventKinematics const &Kinematics(size_t i) const { return kinematics[i]; }
+
+  GHepRecordSpan subspan(size_t first, size_t n) const {
+    return GHepRecordSpan(data + first, n,
+                          kinematics ? (kinematics + first) : nullptr);
+  }
+};
+
+typedef std::vector<systtools::event_unit_response_t> batch_response_t;
+
 class IGENIESystProvider_tool : public systtools::ISystProviderTool {
 public:
   IGENIESystProvider_tool(fhicl::ParameterSet const &ps)
@@ -25,6 +64,15 @@ public:
 
   NEW_SYSTTOOLS_EXCEPT(invalid_response);
 
+  /// Returns an independent, fully configured copy of this provider.
+  ///
+  /// Mutable per-event state (weight engines, scratch members) is owned by the
+  /// copy, read-only state such as loaded templates is shared between copies.
+  /// Each thread should use its own clone; Clone itself should be
+  /// called from a single thread as some providers touch GENIE singletons
+  /// while cloning. Clones do not fill validation trees.
+  virtual std::unique_ptr<IGENIESystProvider_tool> Clone() const = 0;
+
 #ifndef NO_ART
   std::unique_ptr<systtools::EventResponse>
   GetEventResponse(art::Event const &ev) {
@@ -59,51 +107,112 @@ public:
   virtual systtools::event_unit_response_t
   GetEventResponse(genie::EventRecord const &) = 0;
 
+  /// Calculates configured response for a given GHep record, re-using an
+  /// already built EventKinematics digest.
+  ///
+  /// Providers that can use the digest should override this, the default
+  /// ignores it.
+  virtual systtools::event_unit_response_t
+  GetEventResponse(genie::EventRecord const &ev, EventKinematics const &) {
+    return GetEventResponse(ev);
+  }
+
+  /// Interaction channels that this provider can give a non-trivial response
+  /// to, valid once the provider is configured.
+  ///
+  /// Callers may skip GetEventResponse for events outside of the mask and use
+  /// GetUnmatchedEventResponse instead. The default matches every event.
+  virtual InteractionMask GetApplicability() { return InteractionMask::All(); }
+
+  /// The response that this provider gives to every event outside of
+  /// GetApplicability. The default is empty.
+  virtual systtools::event_unit_response_t GetUnmatchedEventResponse() {
+    return systtools::event_unit_response_t();
+  }
+
+  /// Writes the configured response for a given GHep record into buf, which
+  /// must have a slot for each of this provider's response parameters.
+  ///
+  /// Providers that can calculate responses in place should override this,
+  /// the default copies the output of GetEventResponse.
+  virtual void FillEventResponse(genie::EventRecord const &ev,
+                                 EventKinematics const &kin,
+                                 ResponseBuffer &buf) {
+    for (systtools::ParamResponses const &pr : GetEventResponse(ev, kin)) {
+      buf.Fill(pr.pid, pr.responses);
+    }
+  }
+
+  /// Calculates configured responses for a batch of GHep records, one
+  /// event_unit_response_t per record, in order.
+  ///
+  /// Providers that can share work between events should override this, the
+  /// default calls GetEventResponse for each record in turn.
+  virtual void GetEventResponses(GHepRecordSpan events,
+                                 batch_response_t &responses) {
+    responses.resize(events.size);
+    for (size_t ev_it = 0; ev_it < events.size; ++ev_it) {
+      responses[ev_it] = events.HasKinematics()
+                             ? GetEventResponse(events[ev_it],
+                                                events.Kinematics(ev_it))
+                             : GetEventResponse(events[ev_it]);
+    }
+  }
+
   systtools::event_unit_response_w_cv_t
   GetEventVariationAndCVResponse(genie::EventRecord const &GenieGHep) {
-    systtools::event_unit_response_w_cv_t responseandCV;
+    return GetEventVariationAndCVResponse(GenieGHep,
+                                          EventKinematics(GenieGHep));
+  }
 
-    systtools::event_unit_response_t prov_response =
-        GetEventResponse(GenieGHep);
+  systtools::event_unit_response_w_cv_t
+  GetEventVariationAndCVResponse(genie::EventRecord const &GenieGHep,
+                                 EventKinematics const &kin) {
+    return BuildVariationAndCVResponse(GetEventResponse(GenieGHep, kin));
+  }
+
+  /// Splits a response calculated by this provider into CV response and
+  /// variations relative to it.
+  systtools::event_unit_response_w_cv_t
+  BuildVariationAndCVResponse(systtools::event_unit_response_t prov_response) {
+    if (!CVLookupBuilt) {
+      BuildCVLookup();
+    }
+
+    systtools::event_unit_response_w_cv_t responseandCV;
+    responseandCV.reserve(prov_response.size());
 
     // Foreach param
     for (systtools::ParamResponses &pr : prov_response) {
-      // Get CV resp
-      systtools::SystParamHeader const &hdr =
-          GetParam(GetSystMetaData(), pr.pid);
+      CVLookup const &cvl = GetCVLookup(pr.pid);
+      systtools::SystParamHeader const &hdr = GetSystMetaData()[cvl.hdr_idx];
 
-      if (pr.responses.size() != hdr.paramVariations.size()) {
+      size_t NVars = hdr.paramVariations.size();
+      if (pr.responses.size() != NVars) {
         throw invalid_response()
             << "[ERROR]: Parameter: " << hdr.prettyName << ", with "
             << hdr.paramVariations.size() << " parameter variations, returned "
             << pr.responses.size() << " responses.";
       }
 
-      double CVResp = hdr.isWeightSystematicVariation ? 1 : 0;
-      size_t NVars = hdr.paramVariations.size();
-
-      double cv_param_val = 0;
-      if (hdr.centralParamValue != systtools::kDefaultDouble) {
-        cv_param_val = hdr.centralParamValue;
-      }
-      for (size_t idx = 0; idx < NVars; ++idx) {
-        if (fabs(cv_param_val - hdr.paramVariations[idx]) <=
-            std::numeric_limits<float>::epsilon()) {
-          CVResp = pr.responses[idx];
-          break;
-        }
-      }
-      // if we didn't find it, the CVResp stays as 1/0 depending on whether it
-      // is a weight or not.
-      for (size_t idx = 0; idx < NVars; ++idx) {
-        if (hdr.isWeightSystematicVariation) {
-          pr.responses[idx] /= CVResp;
+      // if there is no CV variation, the CVResp stays as 1/0 depending on
+      // whether it is a weight or not and the responses are unchanged.
+      double CVResp = cvl.is_weight ? 1 : 0;
+      if (cvl.cv_idx != kNoCVLookupIdx) {
+        CVResp = pr.responses[cvl.cv_idx];
+        double *resps = pr.responses.data();
+        if (cvl.is_weight) {
+          for (size_t idx = 0; idx < NVars; ++idx) {
+            resps[idx] /= CVResp;
+          }
         } else {
-          pr.responses[idx] -= CVResp;
+          for (size_t idx = 0; idx < NVars; ++idx) {
+            resps[idx] -= CVResp;
+          }
         }
       }
 
-      responseandCV.push_back({pr.pid, CVResp, pr.responses});
+      responseandCV.push_back({pr.pid, CVResp, std::move(pr.responses)});
     } // end for parameter response
 
     return responseandCV;
@@ -131,7 +240,161 @@ public:
            "&,systtools::param_value_list_t const &).";
   }
 
+  /// Fixes the parameter--value pairs used by subsequent calls to CalcWeight,
+  /// so that one throw can be applied to many events without repeating its
+  /// configuration.
+  virtual void SetThrow(systtools::param_value_list_t const &vals) {
+    ThrowValues = vals;
+  }
+
+  /// Equivalent to GetEventWeightResponse with the values passed to the last
+  /// SetThrow.
+  virtual double CalcWeight(genie::EventRecord const &ev) {
+    return GetEventWeightResponse(ev, ThrowValues);
+  }
+  virtual double CalcWeight(genie::EventRecord const &ev,
+                            EventKinematics const &) {
+    return CalcWeight(ev);
+  }
+
+  /// Fixes a bank of throws, or universes, each a set of parameter--value
+  /// pairs, used by subsequent calls to CalcThrowBankWeights.
+  ///
+  /// Providers that can prepare universes ahead of time should override this
+  /// and CalcThrowBankWeights. Clones are not guaranteed to inherit the bank.
+  virtual void SetThrowBank(
+      std::vector<systtools::param_value_list_t> const &universes) {
+    ThrowBank = universes;
+  }
+
+  /// Writes the weight of ev in each universe of the last SetThrowBank to
+  /// weights, which is resized to the number of universes.
+  ///
+  /// The default applies each universe in turn with SetThrow and CalcWeight.
+  virtual void CalcThrowBankWeights(genie::EventRecord const &ev,
+                                    EventKinematics const &kin,
+                                    std::vector<double> &weights) {
+    weights.resize(ThrowBank.size());
+    for (size_t u_it = 0; u_it < ThrowBank.size(); ++u_it) {
+      SetThrow(ThrowBank[u_it]);
+      weights[u_it] = CalcWeight(ev, kin);
+    }
+  }
+  std::vector<double> CalcThrowBankWeights(genie::EventRecord const &ev) {
+    std::vector<double> weights;
+    CalcThrowBankWeights(ev, EventKinematics(ev), weights);
+    return weights;
+  }
+
   std::string fGENIEModuleLabel;
+
+protected:
+  /// Returns the output of FillEventResponse in the allocating
+  /// event_unit_response_t form, for providers that calculate their responses
+  /// in place.
+  systtools::event_unit_response_t
+  GetEventResponseFromFill(genie::EventRecord const &ev,
+                           EventKinematics const &kin) {
+    if (!FillScratchBuilt) {
+      FillScratch.AddParameters(GetSystMetaData());
+      FillScratchBuilt = true;
+    }
+    FillScratch.Clear();
+    FillEventResponse(ev, kin, FillScratch);
+    systtools::event_unit_response_t resp;
+    FillScratch.AppendTo(resp);
+    return resp;
+  }
+
+  /// Writes GetDefaultEventResponse into buf, which is only built once.
+  void FillDefaultEventResponse(ResponseBuffer &buf) {
+    if (!DefaultResponseBuilt) {
+      DefaultResponse = GetDefaultEventResponse();
+      DefaultResponseBuilt = true;
+    }
+    for (systtools::ParamResponses const &pr : DefaultResponse) {
+      buf.Fill(pr.pid, pr.responses);
+    }
+  }
+
+private:
+  systtools::param_value_list_t ThrowValues;
+  std::vector<systtools::param_value_list_t> ThrowBank;
+
+  /// Built on first use, once the provider is configured. Clones copy them.
+  ResponseBuffer FillScratch;
+  bool FillScratchBuilt = false;
+  systtools::event_unit_response_t DefaultResponse;
+  bool DefaultResponseBuilt = false;
+
+  constexpr static size_t kNoCVLookupIdx = std::numeric_limits<size_t>::max();
+
+  /// Per-parameter information used to split responses into CV and
+  /// variations, fixed once the provider is configured.
+  struct CVLookup {
+    size_t hdr_idx;
+    /// Index of the variation at the central value, kNoCVLookupIdx if there
+    /// is none.
+    size_t cv_idx;
+    bool is_weight;
+  };
+
+  /// Indexed by paramId - CVLookupFirstPid
+  std::vector<CVLookup> CVLookupTable;
+  size_t CVLookupFirstPid = 0;
+  bool CVLookupBuilt = false;
+
+  /// Built on first use rather than during SetupResponseCalculator so that
+  /// providers need not call it themselves. Clones copy the built table.
+  void BuildCVLookup() {
+    systtools::SystMetaData const &md = GetSystMetaData();
+
+    CVLookupTable.clear();
+    CVLookupFirstPid = 0;
+    if (md.size()) {
+      size_t min_pid = std::numeric_limits<size_t>::max(), max_pid = 0;
+      for (systtools::SystParamHeader const &hdr : md) {
+        min_pid = std::min(min_pid, size_t(hdr.systParamId));
+        max_pid = std::max(max_pid, size_t(hdr.systParamId));
+      }
+      CVLookupFirstPid = min_pid;
+      CVLookupTable.assign(max_pid - min_pid + 1,
+                           CVLookup{kNoCVLookupIdx, kNoCVLookupIdx, true});
+    }
+
+    for (size_t hdr_idx = 0; hdr_idx < md.size(); ++hdr_idx) {
+      systtools::SystParamHeader const &hdr = md[hdr_idx];
+      CVLookup &cvl =
+          CVLookupTable[size_t(hdr.systParamId) - CVLookupFirstPid];
+      cvl.hdr_idx = hdr_idx;
+      cvl.is_weight = hdr.isWeightSystematicVariation;
+
+      double cv_param_val = 0;
+      if (hdr.centralParamValue != systtools::kDefaultDouble) {
+        cv_param_val = hdr.centralParamValue;
+      }
+      for (size_t idx = 0; idx < hdr.paramVariations.size(); ++idx) {
+        if (fabs(cv_param_val - hdr.paramVariations[idx]) <=
+            std::numeric_limits<float>::epsilon()) {
+          cvl.cv_idx = idx;
+          break;
+        }
+      }
+    }
+    CVLookupBuilt = true;
+  }
+
+  CVLookup const &GetCVLookup(systtools::paramId_t pid) {
+    size_t idx = size_t(pid) - CVLookupFirstPid;
+    if ((size_t(pid) < CVLookupFirstPid) || (idx >= CVLookupTable.size()) ||
+        (CVLookupTable[idx].hdr_idx == kNoCVLookupIdx)) {
+      throw invalid_response()
+          << "[ERROR]: Provider " << GetFullyQualifiedName()
+          << " returned a response for parameter " << pid
+          << ", which it does not own.";
+    }
+    return CVLookupTable[idx];
+  }
 };
 } // namespace nusyst
 
@@ -0,0 +1,160 @@
+#ifndef nusystematics_INTERFACE_RESPONSEBUFFER_SEEN
+#define nusystematics_INTERFACE_RESPONSEBUFFER_SEEN
+
+#include "systematicstools/interface/SystMetaData.hh"
+#include "systematicstools/interface/types.hh"
+
+#include "systematicstools/utility/exceptions.hh"
+
+#include <limits>
+#include <vector>
+
+namespace nusyst {
+
+NEW_SYSTTOOLS_EXCEPT(invalid_response_buffer_access);
+
+/// Flat, parameter-indexed storage for the variation responses of one event.
+///
+/// Slots are laid out once from SystMetaData, one per response parameter with
+/// one element per parameter variation, or one for corrections. Clear only forgets which slots were
+/// written, so a single buffer can be re-used for every event without
+/// allocating.
+class ResponseBuffer {
+  constexpr static size_t kNoSlot = std::numeric_limits<size_t>::max();
+
+  struct Slot {
+    size_t offset;
+    size_t size;
+    bool filled;
+  };
+
+  std::vector<Slot> slots;
+  std::vector<double> data;
+  std::vector<systtools::paramId_t> filled;
+  size_t NSlots = 0;
+
+  Slot const *GetSlot(systtools::paramId_t pid) const {
+    size_t idx = static_cast<size_t>(pid);
+    if ((idx >= slots.size()) || (slots[idx].offset == kNoSlot)) {
+      return nullptr;
+    }
+    return &slots[idx];
+  }
+
+public:
+  ResponseBuffer() {}
+  explicit ResponseBuffer(systtools::SystMetaData const &md) {
+    AddParameters(md);
+  }
+
+  /// Adds a slot for each response parameter in md that does not already
+  /// have one.
+  void AddParameters(systtools::SystMetaData const &md) {
+    for (systtools::SystParamHeader const &hdr : md) {
+      if (hdr.isResponselessParam) {
+        continue;
+      }
+      size_t idx = static_cast<size_t>(hdr.systParamId);
+      if (idx >= slots.size()) {
+        slots.resize(idx + 1, Slot{kNoSlot, 0, false});
+      }
+      if (slots[idx].offset != kNoSlot) {
+        continue;
+      }
+      // Corrections have a single response, at the central value.
+      size_t NResponses = hdr.isCorrection ? 1 : hdr.paramVariations.size();
+      slots[idx] = Slot{data.size(), NResponses, false};
+      data.resize(data.size() + NResponses, 0);
+      NSlots++;
+    }
+    filled.reserve(NSlots);
+  }
+
+  /// Forgets all responses written since the last call.
+  void Clear() {
+    for (systtools::paramId_t pid : filled) {
+      slots[static_cast<size_t>(pid)].filled = false;
+    }
+    filled.clear();
+  }
+
+  bool HasParam(systtools::paramId_t pid) const { return GetSlot(pid); }
+  bool IsFilled(systtools::paramId_t pid) const {
+    Slot const *s = GetSlot(pid);
+    return s && s->filled;
+  }
+
+  size_t GetNResponses(systtools::paramId_t pid) const {
+    Slot const *s = GetSlot(pid);
+    return s ? s->size : 0;
+  }
+
+  /// Returns a pointer to the GetNResponses(pid) elements of the slot for pid
+  /// without marking it as filled.
+  ///
+  /// Allows a response to be calculated in place and only kept, via
+  /// SetFilled, if the event turns out to be affected.
+  double *GetWriteBuffer(systtools::paramId_t pid) {
+    Slot const *s = GetSlot(pid);
+    if (!s) {
+      throw invalid_response_buffer_access()
+          << "[ERROR]: Attempted to fill responses for parameter " << pid
+          << ", which has no slot in this ResponseBuffer.";
+    }
+    return data.data() + s->offset;
+  }
+
+  void SetFilled(systtools::paramId_t pid) {
+    GetWriteBuffer(pid);
+    Slot &slot = slots[static_cast<size_t>(pid)];
+    if (!slot.filled) {
+      slot.filled = true;
+      filled.push_back(pid);
+    }
+  }
+
+  /// Marks the slot for pid as filled and returns a pointer to its
+  /// GetNResponses(pid) elements for writing.
+  double *Fill(systtools::paramId_t pid) {
+    SetFilled(pid);
+    return GetWriteBuffer(pid);
+  }
+
+  void Fill(systtools::paramId_t pid, std::vector<double> const &responses) {
+    if (responses.size() != GetNResponses(pid)) {
+      throw invalid_response_buffer_access()
+          << "[ERROR]: Attempted to fill " << responses.size()
+          << " responses for parameter " << pid << ", which has "
+          << GetNResponses(pid) << " variations.";
+    }
+    double *out = Fill(pid);
+    for (size_t i = 0; i < responses.size(); ++i) {
+      out[i] = responses[i];
+    }
+  }
+
+  /// Returns nullptr if pid has not been filled since the last Clear.
+  double const *GetResponses(systtools::paramId_t pid) const {
+    Slot const *s = GetSlot(pid);
+    return (s && s->filled) ? (data.data() + s->offset) : nullptr;
+  }
+
+  /// Parameters filled since the last Clear, in the order they were filled.
+  std::vector<systtools::paramId_t> const &GetFilledParams() const {
+    return filled;
+  }
+
+  /// Appends filled responses in the allocating event_unit_response_t form.
+  void AppendTo(systtools::event_unit_response_t &resp) const {
+    for (systtools::paramId_t pid : filled) {
+      Slot const &s = slots[static_cast<size_t>(pid)];
+      resp.push_back({pid, std::vector<double>(data.data() + s.offset,
+                                               data.data() + s.offset +
+                                                   s.size)});
+    }
+  }
+};
+
+} // namespace nusyst
+
+#endif
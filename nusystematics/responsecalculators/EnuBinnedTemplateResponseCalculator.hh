@@ -4,6 +4,7 @@
 #include "systematicstools/utility/ROOTUtility.hh"
 
 #include "nusystematics/responsecalculators/TemplateResponseCalculatorBase.hh"
+#include "nusystematics/utility/AxisLookup.hh"
 
 #include "systematicstools/utility/string_parsers.hh"
 
@@ -16,6 +17,9 @@ NEW_SYSTTOOLS_EXCEPT(non_contiguous_enu_range);
 ///
 /// Must be specialized with a TemplateResponseCalculator subclass that knows
 /// how to search for bins, see MKSinglePiTemplate_ReWeight.hh for an example
+///
+/// The templates of each Enu stop are loaded through TRC, so are shared with
+/// any other calculator in the process that uses the same inputs.
 template <class TRC> class EnuBinnedTemplateResponseCalculator {
 public:
   typedef Int_t enu_bin_it_t;
@@ -33,6 +37,8 @@ private:
 
   std::vector<double> EnuBinning;
   std::vector<TRC> EnuResponses;
+  /// Built from EnuBinning once it has been loaded.
+  AxisLookup EnuAxis;
 
   /// Reads and loads input fhicl
   ///
@@ -64,6 +70,9 @@ private:
   ///      }
   ///    ] # optional if all of input_file_pattern, input_hist_pattern,
   ///      # e_uniform, and param_values are specified
+  ///    template_bank: "templates.bank" # optional, passed on to each
+  ///                                    # e_stop, see
+  ///                                    # TemplateResponseCalculatorBase
   /// }
   void LoadInputHistograms(fhicl::ParameterSet const &ps) {
     bool uniform_enu = false;
@@ -132,7 +141,8 @@ private:
                              ps.get<bool>("use_FW_SEARCH_PATH", false));
 #endif
         EnuResponses.emplace_back();
-        EnuResponses.back().LoadInputHistograms(estop_descriptor);
+        EnuResponses.back().LoadInputHistograms(
+            InheritTemplateBankOptions(ps, estop_descriptor));
       }
       return;
     }
@@ -211,35 +221,32 @@ private:
       }
       estop_descriptor.put("inputs", value_descriptors);
       EnuResponses.emplace_back();
-      EnuResponses.back().LoadInputHistograms(estop_descriptor);
+      EnuResponses.back().LoadInputHistograms(
+          InheritTemplateBankOptions(ps, estop_descriptor));
     }
   }
 
   enu_bin_it_t GetEnuBin(double enu_GeV) const {
-    if (EnuBinning.size() < 2) {
-      return kBinOutsideRange;
-    }
-    if ((enu_GeV < EnuBinning.front()) || (enu_GeV >= EnuBinning.back())) {
+    int bin = EnuAxis.FindBin(enu_GeV, AxisLookup::FlowPolicy::kOutsideRange);
+    if (bin == AxisLookup::kOutsideRange) {
       return kBinOutsideRange;
     }
-    for (enu_bin_it_t bi_it = 0; bi_it < enu_bin_it_t(EnuBinning.size() - 1);
-         ++bi_it) {
-      if ((enu_GeV >= EnuBinning[bi_it]) && (enu_GeV < EnuBinning[bi_it + 1])) {
-        return bi_it;
-      }
-    }
-    return kBinOutsideRange;
+    return bin - 1;
   }
 
 public:
   EnuBinnedTemplateResponseCalculator(fhicl::ParameterSet const &ps) {
     LoadInputHistograms(ps);
+    if (EnuBinning.size() >= 2) {
+      EnuAxis = AxisLookup(EnuBinning);
+    }
   };
 
   EnuBinnedTemplateResponseCalculator(
       EnuBinnedTemplateResponseCalculator &&other)
       : EnuBinning(std::move(other.EnuBinning)),
-        EnuResponses(std::move(other.EnuResponses)) {}
+        EnuResponses(std::move(other.EnuResponses)),
+        EnuAxis(std::move(other.EnuAxis)) {}
 
   virtual std::pair<enu_bin_it_t, typename TRC::bin_it_t>
   GetBin(double enu_GeV,
@@ -258,16 +265,54 @@ public:
   double
   GetVariation(double val,
                std::pair<enu_bin_it_t, typename TRC::bin_it_t> bin) const {
+    if (bin.first == kBinOutsideRange) {
+      return 1;
+    }
     return EnuResponses[bin.first].GetVariation(val, bin.second);
   }
 
+  /// Responses of a bin to each of the valid variations, nullptr outside of
+  /// the templates.
+  double const *
+  GetBinResponses(std::pair<enu_bin_it_t, typename TRC::bin_it_t> bin) const {
+    if (bin.first == kBinOutsideRange) {
+      return nullptr;
+    }
+    return EnuResponses[bin.first].GetBinResponses(bin.second);
+  }
+
   double
   GetVariation(double val, double enu_GeV,
                std::array<double, TRC::NDimensions> const &kinematics) const {
     return GetVariation(val, GetBin(enu_GeV, kinematics));
   }
 
-  bool IsValidVariation(double val) {
+  /// Slots of a set of values per Enu bin, [enu_bin][value], as each Enu bin
+  /// may have been loaded at a different set of values.
+  typedef std::vector<std::vector<size_t>> variation_indices_t;
+
+  variation_indices_t
+  ResolveVariationIndices(std::vector<double> const &vals) const {
+    variation_indices_t slots;
+    for (TRC const &resp : EnuResponses) {
+      slots.push_back(resp.ResolveVariationIndices(vals));
+    }
+    return slots;
+  }
+
+  /// Response of bin to value v_it of those resolved to slots, unity outside
+  /// of the templates or where the value resolved to TRC::kNoSlot.
+  double GetVariationByIndex(
+      variation_indices_t const &slots, size_t v_it,
+      std::pair<enu_bin_it_t, typename TRC::bin_it_t> bin) const {
+    if (bin.first == kBinOutsideRange) {
+      return 1;
+    }
+    return EnuResponses[bin.first].GetVariationByIndex(slots[bin.first][v_it],
+                                                       bin.second);
+  }
+
+  bool IsValidVariation(double val) const {
     return EnuResponses.front().IsValidVariation(val);
   }
 };
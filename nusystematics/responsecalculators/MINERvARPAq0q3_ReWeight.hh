@@ -25,6 +25,19 @@ class MINERvARPAq0q3_ReWeight
 
   enum bin_indices { kIndex_q0 = 0, kIndex_q3 = 1 };
 
+  // The templates are binned in q3 along X and q0 along Y. Events outside of
+  // the Valencia calculation phase space are held at the closest valid bin.
+  int GetQ3Bin(double q3_GeV) const {
+    return GetAxis(0).FindBin(q3_GeV, AxisLookup::FlowPolicy::kClamp);
+  }
+  int GetQ0Bin(double q0_GeV) const {
+    if (q0_GeV < 0.018) {
+      q0_GeV = 0.018 + q0_offsetValenciaGENIE_GeV;
+    }
+    return GetAxis(1).FindBin(q0_GeV - q0_offsetValenciaGENIE_GeV,
+                              AxisLookup::FlowPolicy::kClamp);
+  }
+
 public:
   enum class RPATweak_t { kCV = 0, kPlus1 = 1, kMinus1 = -1 };
 
@@ -33,46 +46,18 @@ public:
   }
 
   virtual bin_it_t GetBin(std::array<double, 2> const &kinematics) const {
-
-    std::array<double, 2> kinematics_var = kinematics;
-
-    // Hold events outside of the Valencia calculation phase space at the
-    // closest valid bin.
-    if (kinematics_var[kIndex_q0] < 0.018) {
-      kinematics_var[kIndex_q0] = 0.018 + q0_offsetValenciaGENIE_GeV;
-    }
-
-    TH2 *firstHist = BinnedResponses.begin()->second.get();
-
-    Int_t XBin = firstHist->GetXaxis()->FindFixBin(kinematics[kIndex_q3]);
-    // Hold events outside of the Valencia calculation phase space at the
-    // closest valid bin.
-    if (IsFlowBin(firstHist->GetXaxis(), XBin)) {
-      XBin = (XBin == 0) ? XBin + 1 : XBin - 1;
-    }
+    int XBin = GetQ3Bin(kinematics[kIndex_q3]);
+    int YBin = GetQ0Bin(kinematics[kIndex_q0]);
 #ifdef MINERvARPAq0q3_ReWeight_DEBUG
     std::cout << "\t\tXBin: " << XBin << " from " << kinematics[kIndex_q3]
+              << ", YBin: " << YBin << " from " << kinematics[kIndex_q0]
               << std::endl;
 #endif
-
-    Int_t YBin = firstHist->GetYaxis()->FindFixBin(kinematics_var[kIndex_q0] -
-                                                   q0_offsetValenciaGENIE_GeV);
-    // Hold events outside of the Valencia calculation phase space at the
-    // closest valid bin.
-    if (IsFlowBin(firstHist->GetYaxis(), YBin)) {
-      YBin = (YBin == 0) ? YBin + 1 : YBin - 1;
-    }
-
-#ifdef MINERvARPAq0q3_ReWeight_DEBUG
-    std::cout << "\t\tYBin: " << YBin << " from "
-              << (kinematics_var[kIndex_q0] - q0_offsetValenciaGENIE_GeV)
-              << std::endl;
-#endif
-
-    return firstHist->GetBin(XBin, YBin);
+    return GetGlobalBin({{XBin, YBin}});
   }
 
-  double GetWeightQ2(const double Q2_GeV2, RPATweak_t tweak = RPATweak_t::kCV) {
+  double GetWeightQ2(const double Q2_GeV2,
+                     RPATweak_t tweak = RPATweak_t::kCV) const {
 
     if (Q2Lims[0] < 0.0) {
       return 1.0;
@@ -107,7 +92,7 @@ public:
   }
 
   double GetWeight(double q0_GeV, double q3_GeV,
-                   RPATweak_t tweak = RPATweak_t::kCV) {
+                   RPATweak_t tweak = RPATweak_t::kCV) const {
 
     double weight = 1;
     double Q2_GeV2 = (q3_GeV * q3_GeV) - (q0_GeV * q0_GeV);
@@ -121,7 +106,9 @@ public:
       if (Q2_GeV2 > 3.0) {
         weight = GetWeightQ2(Q2_GeV2, tweak);
       } else {
-        int bin2d = GetBin(std::array<double, 2>{{q0_GeV, q3_GeV}});
+        // The q0 bin is shared with the bulk bin fallback.
+        int YBin = GetQ0Bin(q0_GeV);
+        int bin2d = GetGlobalBin({{GetQ3Bin(q3_GeV), YBin}});
 #ifdef MINERvARPAq0q3_ReWeight_DEBUG
         std::cout << "\t\tGot bin: " << bin2d << std::endl;
 #endif
@@ -136,7 +123,7 @@ public:
         // events in genie but not in valencia should get a weight
         // related to a similar q0 from the bulk distribution.
         if ((q0_GeV < 0.15) && (weight > 0.9)) {
-          bin2d = GetBin(std::array<double, 2>{{q0_GeV, q3_GeV + 0.15}});
+          bin2d = GetGlobalBin({{GetQ3Bin(q3_GeV + 0.15), YBin}});
 #ifdef MINERvARPAq0q3_ReWeight_DEBUG
           std::cout << "\t\t[INFO]: Moved to bulk bin: " << bin2d << std::endl;
 #endif
@@ -1,6 +1,10 @@
 #ifndef nusystematics_RESPONSE_CALCULATORS_TEMPLATE_RESPONSE_BASE_HH_SEEN
 #define nusystematics_RESPONSE_CALCULATORS_TEMPLATE_RESPONSE_BASE_HH_SEEN
 
+#include "nusystematics/utility/AlignedAllocator.hh"
+#include "nusystematics/utility/AxisLookup.hh"
+#include "nusystematics/utility/TemplateBank.hh"
+
 #include "systematicstools/interface/types.hh"
 
 #include "systematicstools/interpreters/PolyResponse.hh"
@@ -14,11 +18,23 @@
 #include "cetlib/search_path.h"
 #endif
 
+#include "TAxis.h"
 #include "TH1.h"
 #include "TH2.h"
 #include "TH3.h"
 #include "TSpline.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 // #define TemplateResponseCalculatorBase_DEBUG
 
 namespace nusyst {
@@ -27,32 +43,147 @@ NEW_SYSTTOOLS_EXCEPT(no_responses_loaded);
 NEW_SYSTTOOLS_EXCEPT(incompatible_number_of_bins);
 NEW_SYSTTOOLS_EXCEPT(bad_value_ordering);
 
+/// Copies the template bank options of a manifest onto the manifest of one of
+/// the templates that it configures, unless that sets its own.
+inline fhicl::ParameterSet
+InheritTemplateBankOptions(fhicl::ParameterSet const &parent,
+                           fhicl::ParameterSet child) {
+  if (parent.has_key("template_bank") && !child.has_key("template_bank")) {
+    child.put("template_bank", parent.get<std::string>("template_bank"));
+  }
+  if (parent.has_key("verify_template_bank") &&
+      !child.has_key("verify_template_bank")) {
+    child.put("verify_template_bank",
+              parent.get<bool>("verify_template_bank"));
+  }
+  return child;
+}
+
+
 template <size_t NDims, bool Continuous = true, size_t PolyResponseOrder = 5>
 class TemplateResponseCalculatorBase {
 
 protected:
-  std::vector<systtools::PolyResponse<PolyResponseOrder>>
-      InterpolatedBinResponses;
+  /// The loaded contents of a set of templates, shared by every calculator in
+  /// the process that loads the same inputs and never modified once built.
+  struct SharedTemplate {
+    /// Parameter values of the loaded templates, in ascending order.
+    std::vector<double> ValidValues;
+    /// Bin lookups for each axis of the templates.
+    std::array<AxisLookup, NDims> Axes;
+    size_t NFlatBins = 0;
+    /// Template contents laid out [bin][value] over every bin, including flow
+    /// bins, so that the responses of one bin to all values are contiguous.
+    /// Points into either FlatResponses or the mapped contents of Bank.
+    double const *Responses = nullptr;
+    cache_aligned_vector<double> FlatResponses;
+    std::shared_ptr<TemplateBank const> Bank;
+    std::vector<systtools::PolyResponse<PolyResponseOrder>>
+        InterpolatedBinResponses;
+  };
+  typedef std::function<std::string(std::string)> file_resolver_t;
+
+  /// The input histograms, only loaded into, and kept by, this calculator if
+  /// keep_input_histograms is set.
   std::map<double, std::unique_ptr<typename THType<NDims>::type>>
       BinnedResponses;
 
+  std::shared_ptr<SharedTemplate const> Shared;
+  /// Copied from Shared for the per-event lookups.
+  double const *Responses;
+  size_t NValues;
+  size_t NFlatBins;
+
+  static AxisLookup BuildAxisLookup(TAxis const *axis) {
+    if (axis->GetXbins()->fN) {
+      return AxisLookup(std::vector<double>(
+          axis->GetXbins()->GetArray(),
+          axis->GetXbins()->GetArray() + axis->GetXbins()->fN));
+    }
+    return AxisLookup(axis->GetNbins(), axis->GetXmin(), axis->GetXmax());
+  }
+  void BuildAxisLookups(SharedTemplate &tmpl) const;
+
   void ValidateInputHistograms();
-  void BuildInterpolatedResponses();
+  void FlattenInputHistograms(SharedTemplate &tmpl) const;
+  static void BuildInterpolatedResponses(SharedTemplate &tmpl);
+
+  /// Identifies the templates described by ps from their values and their
+  /// file and histogram names, with the file names passed through resolve.
+  static std::string GetInputsKey(fhicl::ParameterSet const &ps,
+                                  file_resolver_t const &resolve);
+  /// Reads the input histograms, keeping them in BinnedResponses if
+  /// keep_histograms is set.
+  std::shared_ptr<SharedTemplate>
+  LoadInputFiles(fhicl::ParameterSet const &ps, file_resolver_t const &resolve,
+                 bool keep_histograms);
+  /// Returns nullptr if the bank holds no templates under key.
+  static std::shared_ptr<SharedTemplate>
+  LoadTemplateBank(std::string const &bank_file, std::string const &key,
+                   bool verify);
+
+  /// Returns the templates cached under key if any calculator in the process
+  /// still holds them, otherwise caches and returns the result of load.
+  ///
+  /// Loads are serialized, so that concurrent calculators configured with
+  /// the same inputs read them once.
+  static std::shared_ptr<SharedTemplate const> GetSharedTemplate(
+      std::string const &key,
+      std::function<std::shared_ptr<SharedTemplate>()> const &load);
+
+  static bool IsFlowBin(std::array<AxisLookup, NDims> const &axes,
+                        size_t bin) {
+    for (size_t d_it = 0; d_it < NDims; ++d_it) {
+      size_t NAxisBins = axes[d_it].GetNBins() + 2;
+      if (axes[d_it].IsFlowBin(int(bin % NAxisBins))) {
+        return true;
+      }
+      bin /= NAxisBins;
+    }
+    return false;
+  }
+
+  AxisLookup const &GetAxis(size_t dim) const { return Shared->Axes[dim]; }
+
+  /// nullptr unless keep_input_histograms was set.
+  typename THType<NDims>::type *GetBinningHistogram() const {
+    return BinnedResponses.size() ? BinnedResponses.begin()->second.get()
+                                  : nullptr;
+  }
+
+  /// Index of val in the loaded values, throws if val is not a loaded value.
+  size_t GetValueIndex(double val) const;
 
 public:
   static size_t const NDimensions = NDims;
   TemplateResponseCalculatorBase();
   TemplateResponseCalculatorBase(TemplateResponseCalculatorBase &&other)
-      : InterpolatedBinResponses(std::move(other.InterpolatedBinResponses)),
-        BinnedResponses(std::move(other.BinnedResponses)) {}
+      : BinnedResponses(std::move(other.BinnedResponses)),
+        Shared(std::move(other.Shared)), Responses(other.Responses),
+        NValues(other.NValues), NFlatBins(other.NFlatBins) {}
 
   /// Reads and loads input fhicl
   ///
+  /// Templates are cached for the lifetime of the process by their resolved
+  /// inputs, calculators configured with the same inputs share one copy.
+  ///
   /// Expected fhicl like:
   ///  use_FW_SEARCH_PATH: true # If enabled, will search for files in
   ///  in the search path. Only read for ART jobs.
   ///  input_file: "file.root" # Optional default root file name for this
   ///                          # parameter's inputs
+  ///  keep_input_histograms: false # Optional, the histograms are otherwise
+  ///                               # released once their contents have been
+  ///                               # copied to the flat response table. When
+  ///                               # set, this calculator reads its own copy
+  ///                               # of the inputs.
+  ///  template_bank: "templates.bank" # Optional, read the templates from a
+  ///                                  # bank written by
+  ///                                  # ConvertTemplateBankNuSyst instead,
+  ///                                  # falling back to the input files if
+  ///                                  # the bank does not hold them.
+  ///  verify_template_bank: true # Optional, check the bank checksum when it
+  ///                             # is first mapped.
   ///    inputs: [
   ///      { value: 0
   ///        input_file: "file.root" # Optional if the less-specific is
@@ -65,8 +196,42 @@ public:
 
   typedef Int_t bin_it_t;
 
+  /// kBinOutsideRange if any of the values lie outside of their axis.
   virtual bin_it_t GetBin(std::array<double, NDims> const &) const;
 
+  /// The global bin, numbered as TH1::GetBin, of a bin on each axis.
+  bin_it_t GetGlobalBin(std::array<int, NDims> const &axis_bins) const {
+    bin_it_t bin = 0;
+    for (size_t d_it = NDims; d_it > 0; --d_it) {
+      bin = bin * bin_it_t(Shared->Axes[d_it - 1].GetNBins() + 2) +
+            axis_bins[d_it - 1];
+    }
+    return bin;
+  }
+
+  /// Responses of a bin to each of GetValidVariations, nullptr for
+  /// kBinOutsideRange.
+  double const *GetBinResponses(bin_it_t bin) const;
+  size_t GetNValues() const { return NValues; }
+
+  constexpr static size_t kNoSlot = std::numeric_limits<size_t>::max();
+
+  /// Resolves each of a set of discrete parameter values, usually a
+  /// parameter's paramVariations, to its slot in the response table once,
+  /// so that events can be evaluated with GetVariationByIndex.
+  ///
+  /// A value of 0 that was not loaded gets kNoSlot, other values that were
+  /// not loaded throw.
+  std::vector<size_t>
+  ResolveVariationIndices(std::vector<double> const &vals) const;
+
+  /// Response of bin to the value in slot, unity for kBinOutsideRange and
+  /// kNoSlot.
+  double GetVariationByIndex(size_t slot, bin_it_t bin) const {
+    double const *resps = GetBinResponses(bin);
+    return (resps && (slot != kNoSlot)) ? resps[slot] : 1;
+  }
+
   virtual std::string GetCalculatorName() const = 0;
   
   // virtual destructor required
@@ -123,43 +288,223 @@ void TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
   bool use_stashcache = ps.get<bool>("use_FW_SEARCH_PATH", false);
 #endif
 
-  std::string const &default_root_file = ps.get<std::string>("input_file", "");
-
-  for (fhicl::ParameterSet const &val_config :
-       ps.get<std::vector<fhicl::ParameterSet>>("inputs")) {
-    double pval = val_config.get<double>("value");
-    std::string input_file =
-        val_config.get<std::string>("input_file", default_root_file);
-    std::string input_hist = val_config.get<std::string>("input_hist");
-
+  file_resolver_t ResolveFile = [&](std::string file) {
 #ifndef NO_ART
-
     if (use_stashcache) {
       std::string stashcache_file;
       cet::search_path sp("FW_SEARCH_PATH");
-      if (!sp.find_file(input_file, stashcache_file)) {
+      if (!sp.find_file(file, stashcache_file)) {
         char *fw = getenv("FW_SEARCH_PATH");
         std::string fw_str("");
         if (fw) {
           fw_str = fw;
         }
         throw invalid_tfile()
-            << "[ERROR]: Failed to find file: " << input_file
+            << "[ERROR]: Failed to find file: " << file
             << ", on stashcache. (FW_SEARCH_PATH=\"" << fw_str << "\")";
       }
-      input_file = stashcache_file;
+      file = stashcache_file;
     }
-
 #endif
+    return file;
+  };
+
+  // While a bank is being written, every template is read from its inputs.
+  TemplateBankWriter *recorder = TemplateBankWriter::Recording();
+  std::string const &bank_file = ps.get<std::string>("template_bank", "");
+  std::string const &bank_key =
+      GetInputsKey(ps, [](std::string file) { return file; });
+
+  Shared = nullptr;
+  if (!recorder && bank_file.size()) {
+    std::string bank_path = ResolveFile(bank_file);
+    bool verify = ps.get<bool>("verify_template_bank", true);
+    Shared = GetSharedTemplate(bank_path + "#" + bank_key, [&]() {
+      return LoadTemplateBank(bank_path, bank_key, verify);
+    });
+    if (!Shared) {
+      std::cout << "[INFO]: Template bank " << std::quoted(bank_file)
+                << " does not hold the templates: " << bank_key
+                << ", reading them from their input files." << std::endl;
+    }
+  }
+
+  if (!Shared) {
+    if (ps.get<bool>("keep_input_histograms", false)) {
+      Shared = LoadInputFiles(ps, ResolveFile, true);
+    } else {
+      Shared = GetSharedTemplate(GetInputsKey(ps, ResolveFile), [&]() {
+        return LoadInputFiles(ps, ResolveFile, false);
+      });
+    }
+    if (recorder) {
+      recorder->AddTemplate(
+          bank_key,
+          std::vector<AxisLookup>(Shared->Axes.begin(), Shared->Axes.end()),
+          Shared->ValidValues, Shared->Responses, Shared->NFlatBins);
+    }
+  }
+
+  Responses = Shared->Responses;
+  NValues = Shared->ValidValues.size();
+  NFlatBins = Shared->NFlatBins;
+}
+
+template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
+std::shared_ptr<typename TemplateResponseCalculatorBase<
+    NDims, Continuous, PolyResponseOrder>::SharedTemplate>
+TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    LoadInputFiles(fhicl::ParameterSet const &ps,
+                   file_resolver_t const &resolve, bool keep_histograms) {
+  std::string const &default_root_file = ps.get<std::string>("input_file", "");
+
+  BinnedResponses.clear();
+  for (fhicl::ParameterSet const &val_config :
+       ps.get<std::vector<fhicl::ParameterSet>>("inputs")) {
+    double pval = val_config.get<double>("value");
+    std::string input_file = resolve(
+        val_config.get<std::string>("input_file", default_root_file));
+    std::string input_hist = val_config.get<std::string>("input_hist");
 
     BinnedResponses[pval] = std::unique_ptr<typename THType<NDims>::type>(
         GetHistogram<typename THType<NDims>::type>(input_file, input_hist));
   }
 
   ValidateInputHistograms();
+  std::shared_ptr<SharedTemplate> tmpl = std::make_shared<SharedTemplate>();
+  FlattenInputHistograms(*tmpl);
+  BuildAxisLookups(*tmpl);
   if (Continuous) {
-    BuildInterpolatedResponses();
+    BuildInterpolatedResponses(*tmpl);
+  }
+
+  if (!keep_histograms) {
+    BinnedResponses.clear();
   }
+  return tmpl;
+}
+
+template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
+std::shared_ptr<typename TemplateResponseCalculatorBase<
+    NDims, Continuous, PolyResponseOrder>::SharedTemplate const>
+TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    GetSharedTemplate(
+        std::string const &key,
+        std::function<std::shared_ptr<SharedTemplate>()> const &load) {
+  static std::mutex cache_mutex;
+  static std::map<std::string, std::weak_ptr<SharedTemplate const>> cache;
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  std::shared_ptr<SharedTemplate const> tmpl;
+  auto cached = cache.find(key);
+  if (cached != cache.end()) {
+    tmpl = cached->second.lock();
+  }
+  if (tmpl) {
+    return tmpl;
+  }
+
+  tmpl = load();
+  // Drop the entries of templates that are no longer held by anyone.
+  for (auto it = cache.begin(); it != cache.end();) {
+    it = it->second.expired() ? cache.erase(it) : std::next(it);
+  }
+  if (tmpl) {
+    cache[key] = tmpl;
+  }
+  return tmpl;
+}
+
+template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
+void TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    FlattenInputHistograms(SharedTemplate &tmpl) const {
+  size_t NTmplValues = BinnedResponses.size();
+  tmpl.NFlatBins =
+      THType<NDims>::GetNbins(BinnedResponses.begin()->second, true);
+
+  tmpl.ValidValues.clear();
+  tmpl.FlatResponses.assign(tmpl.NFlatBins * NTmplValues, 0);
+  for (auto const &val_resp : BinnedResponses) {
+    size_t v_it = tmpl.ValidValues.size();
+    tmpl.ValidValues.push_back(val_resp.first);
+    for (size_t bi_it = 0; bi_it < tmpl.NFlatBins; ++bi_it) {
+      tmpl.FlatResponses[bi_it * NTmplValues + v_it] =
+          val_resp.second->GetBinContent(bi_it);
+    }
+  }
+  tmpl.Responses = tmpl.FlatResponses.data();
+}
+
+template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
+std::string
+TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    GetInputsKey(fhicl::ParameterSet const &ps,
+                 file_resolver_t const &resolve) {
+  std::string const &default_root_file = ps.get<std::string>("input_file", "");
+
+  std::stringstream ss("");
+  ss << NDims << "D";
+  for (fhicl::ParameterSet const &val_config :
+       ps.get<std::vector<fhicl::ParameterSet>>("inputs")) {
+    char value[32];
+    std::snprintf(value, sizeof(value), "%a", val_config.get<double>("value"));
+    ss << "|" << value << ":"
+       << resolve(
+              val_config.get<std::string>("input_file", default_root_file))
+       << ":" << val_config.get<std::string>("input_hist");
+  }
+  return ss.str();
+}
+
+template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
+std::shared_ptr<typename TemplateResponseCalculatorBase<
+    NDims, Continuous, PolyResponseOrder>::SharedTemplate>
+TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    LoadTemplateBank(std::string const &bank_file, std::string const &key,
+                     bool verify) {
+  std::shared_ptr<TemplateBank const> bank =
+      TemplateBank::Open(bank_file, verify);
+
+  TemplateBank::Template bank_tmpl;
+  if (!bank->FindTemplate(key, bank_tmpl)) {
+    return nullptr;
+  }
+  if (bank_tmpl.Axes.size() != NDims) {
+    throw invalid_template_bank()
+        << "[ERROR]: Template bank " << std::quoted(bank_file)
+        << " holds a " << bank_tmpl.Axes.size() << "D template under " << key
+        << ", but expected a " << NDims << "D template.";
+  }
+  if (!bank_tmpl.NValues || (Continuous && (bank_tmpl.NValues == 1))) {
+    throw no_responses_loaded()
+        << "[ERROR]: Template bank " << std::quoted(bank_file) << " holds "
+        << bank_tmpl.NValues << " parameter values under " << key
+        << ", require at least " << (Continuous ? 2 : 1) << ".";
+  }
+
+  std::shared_ptr<SharedTemplate> tmpl = std::make_shared<SharedTemplate>();
+  size_t NExpectedBins = 1;
+  for (size_t d_it = 0; d_it < NDims; ++d_it) {
+    tmpl->Axes[d_it] = bank_tmpl.Axes[d_it];
+    NExpectedBins *= (tmpl->Axes[d_it].GetNBins() + 2);
+  }
+  if (bank_tmpl.NFlatBins != NExpectedBins) {
+    throw incompatible_number_of_bins()
+        << "[ERROR]: Template bank " << std::quoted(bank_file) << " holds "
+        << bank_tmpl.NFlatBins << " bins under " << key
+        << ", but its axes have " << NExpectedBins
+        << " bins, including flow bins.";
+  }
+
+  tmpl->ValidValues.assign(bank_tmpl.Values,
+                           bank_tmpl.Values + bank_tmpl.NValues);
+  tmpl->NFlatBins = bank_tmpl.NFlatBins;
+  tmpl->Responses = bank_tmpl.Responses;
+  tmpl->Bank = std::move(bank);
+  if (Continuous) {
+    BuildInterpolatedResponses(*tmpl);
+  }
+  return tmpl;
 }
 
 template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
@@ -167,44 +512,107 @@ typename TemplateResponseCalculatorBase<NDims, Continuous,
                                         PolyResponseOrder>::bin_it_t
 TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::GetBin(
     std::array<double, NDims> const &vals) const {
-  return THType<NDims>::GetBin(BinnedResponses.begin()->second.get(), vals);
+  std::array<int, NDims> axis_bins;
+  for (size_t d_it = 0; d_it < NDims; ++d_it) {
+    axis_bins[d_it] = Shared->Axes[d_it].FindBin(
+        vals[d_it], AxisLookup::FlowPolicy::kOutsideRange);
+    if (axis_bins[d_it] == AxisLookup::kOutsideRange) {
+      return kBinOutsideRange;
+    }
+  }
+  return GetGlobalBin(axis_bins);
 }
 
 template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
-void TemplateResponseCalculatorBase<
-    NDims, Continuous, PolyResponseOrder>::BuildInterpolatedResponses() {
-  std::vector<double> xvals;
-  std::vector<double> yvals_dummy;
-  std::vector<double> yvals;
-  for (auto const &var : BinnedResponses) {
-    if (var.first < xvals.back()) {
+void TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    BuildAxisLookups(SharedTemplate &tmpl) const {
+  typename THType<NDims>::type const *h = BinnedResponses.begin()->second.get();
+  std::array<TAxis const *, 3> axes{
+      {h->GetXaxis(), h->GetYaxis(), h->GetZaxis()}};
+  for (size_t d_it = 0; d_it < NDims; ++d_it) {
+    tmpl.Axes[d_it] = BuildAxisLookup(axes[d_it]);
+  }
+}
+
+template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
+double const *
+TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    GetBinResponses(bin_it_t bin) const {
+  if (bin == kBinOutsideRange) {
+    return nullptr;
+  }
+  // Clamped as TH1::GetBinContent does.
+  size_t bi_it = (bin < 0) ? 0 : std::min(size_t(bin), NFlatBins - 1);
+  return Responses + bi_it * NValues;
+}
+
+template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
+size_t TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    GetValueIndex(double val) const {
+  std::vector<double> const &ValidValues = Shared->ValidValues;
+  for (size_t v_it = 0; v_it < ValidValues.size(); ++v_it) {
+    if (fabs(val - ValidValues[v_it]) <
+        (std::numeric_limits<double>::epsilon() * 1E4)) {
+      return v_it;
+    }
+  }
+
+  std::stringstream ss("");
+  ss << "[";
+  for (auto const &v : GetValidVariations()) {
+    ss << v << ", ";
+  }
+  std::string valid_vals = ss.str();
+  valid_vals = valid_vals.substr(0, valid_vals.size() - 2) + " ]";
+  throw systtools::invalid_parameter_value()
+      << "[ERROR]: Invalid parameter value, " << val
+      << " used for template response " << GetCalculatorName()
+      << ", configured values: " << valid_vals;
+}
+
+template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
+std::vector<size_t>
+TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    ResolveVariationIndices(std::vector<double> const &vals) const {
+  std::vector<size_t> slots;
+  for (double val : vals) {
+    slots.push_back(((val == 0) && !IsValidVariation(0)) ? kNoSlot
+                                                         : GetValueIndex(val));
+  }
+  return slots;
+}
+
+template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
+void TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    BuildInterpolatedResponses(SharedTemplate &tmpl) {
+  std::vector<double> const &ValidValues = tmpl.ValidValues;
+  for (size_t v_it = 1; v_it < ValidValues.size(); ++v_it) {
+    if (ValidValues[v_it] < ValidValues[v_it - 1]) {
       throw bad_value_ordering()
           << "[ERROR]: When precalculating response functions, found value "
              "specification for "
-          << var.first << ", but the previous value was " << xvals.back()
-          << "; as these are stored in a std::map, this is problematic...";
+          << ValidValues[v_it] << ", but the previous value was "
+          << ValidValues[v_it - 1] << ".";
     }
-    xvals.push_back(var.first);
-    yvals_dummy.push_back(1);
   }
+  std::vector<double> yvals_dummy(ValidValues.size(), 1);
 
-  size_t NBins = THType<NDims>::GetNbins(BinnedResponses.begin()->second, true);
-  for (size_t bi_it = 0; bi_it < NBins; ++bi_it) {
-    yvals.clear();
-    for (auto const &var : BinnedResponses) {
-      if (THType<NDims>::IsFlowBin(var.second, bi_it)) {
-        yvals = yvals_dummy;
-        break;
-      }
-      yvals.push_back(var.second->GetBinContent(bi_it));
+  size_t NTmplValues = ValidValues.size();
+  for (size_t bi_it = 0; bi_it < tmpl.NFlatBins; ++bi_it) {
+    if (IsFlowBin(tmpl.Axes, bi_it)) {
+      tmpl.InterpolatedBinResponses.emplace_back(ValidValues, yvals_dummy);
+      continue;
     }
-    InterpolatedBinResponses.emplace_back(xvals, yvals);
+    double const *row = tmpl.Responses + bi_it * NTmplValues;
+    tmpl.InterpolatedBinResponses.emplace_back(
+        ValidValues, std::vector<double>(row, row + NTmplValues));
   }
 }
 
 template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
-TemplateResponseCalculatorBase<
-    NDims, Continuous, PolyResponseOrder>::TemplateResponseCalculatorBase() {}
+TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
+    TemplateResponseCalculatorBase()
+    : Responses(nullptr), NValues(0), NFlatBins(0) {}
 
 template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
 template <bool IsCont>
@@ -212,7 +620,7 @@ typename std::enable_if<IsCont, double>::type
 TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
     GetVariation(double val,
                  typename std::enable_if<IsCont, bin_it_t>::type bin) const {
-  return InterpolatedBinResponses[bin]->eval(val);
+  return Shared->InterpolatedBinResponses[bin].eval(val);
 }
 
 template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
@@ -222,34 +630,17 @@ TemplateResponseCalculatorBase<NDims, Continuous, PolyResponseOrder>::
     GetVariation(double val,
                  typename std::enable_if<!IsCont, bin_it_t>::type bin) const {
 
-  if (bin == kBinOutsideRange) {
+  double const *resps = GetBinResponses(bin);
+  if (!resps) {
     return 1;
   }
 
-  for (auto const &resp : BinnedResponses) {
-    if (fabs(val - resp.first) <
-        (std::numeric_limits<double>::epsilon() * 1E4)) {
+  size_t v_it = GetValueIndex(val);
 #ifdef TemplateResponseCalculatorBase_DEBUG
-      std::cout << "[INFO]: Getting bin content for bin: " << bin
-                << " at value: " << val << " = "
-                << resp.second->GetBinContent(bin)
-                << " from hist: " << resp.second->GetName() << std::endl;
+  std::cout << "[INFO]: Getting bin content for bin: " << bin
+            << " at value: " << val << " = " << resps[v_it] << std::endl;
 #endif
-      return resp.second->GetBinContent(bin);
-    }
-  }
-
-  std::stringstream ss("");
-  ss << "[";
-  for (auto const &v : GetValidVariations()) {
-    ss << v << ", ";
-  }
-  std::string valid_vals = ss.str();
-  valid_vals = valid_vals.substr(0, valid_vals.size() - 2) + " ]";
-  throw systtools::invalid_parameter_value()
-      << "[ERROR]: Invalid parameter value, " << val
-      << " used for template response " << GetCalculatorName()
-      << ", configured values: " << valid_vals;
+  return resps[v_it];
 }
 
 template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
@@ -263,32 +654,21 @@ template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
 std::vector<double>
 TemplateResponseCalculatorBase<NDims, Continuous,
                                PolyResponseOrder>::GetValidVariations() const {
-  std::vector<double> vals;
+  std::vector<double> const &ValidValues = Shared->ValidValues;
   if (Continuous) {
-    std::pair<double, double> minmax{std::numeric_limits<double>::max(),
-                                     -std::numeric_limits<double>::max()};
-    for (auto const &var : BinnedResponses) {
-      minmax.first = std::min(minmax.first, var.first);
-      minmax.second = std::max(minmax.second, var.first);
-    }
-    vals.push_back(minmax.first);
-    vals.push_back(minmax.second);
-  } else {
-    for (auto const &var : BinnedResponses) {
-      vals.push_back(var.first);
-    }
+    return {ValidValues.front(), ValidValues.back()};
   }
-  return vals;
+  return ValidValues;
 }
 
 template <size_t NDims, bool Continuous, size_t PolyResponseOrder>
 bool TemplateResponseCalculatorBase<
     NDims, Continuous, PolyResponseOrder>::IsValidVariation(double val) const {
-  std::vector<double> const &valvar = GetValidVariations();
+  std::vector<double> const &ValidValues = Shared->ValidValues;
   if (Continuous) {
-    return (val > valvar[0]) && (val < valvar[1]);
+    return (val > ValidValues.front()) && (val < ValidValues.back());
   } else {
-    for (double v : valvar) {
+    for (double v : ValidValues) {
       if (fabs(v - val) < (std::numeric_limits<double>::epsilon() * 1E4)) {
         return true;
       }
@@ -160,14 +160,23 @@ bool BeRPAWeight::SetupResponseCalculator(
 
 event_unit_response_t
 BeRPAWeight::GetEventResponse(genie::EventRecord const &ev) {
+  return GetEventResponse(ev, EventKinematics(ev));
+}
+
+event_unit_response_t
+BeRPAWeight::GetEventResponse(genie::EventRecord const &ev,
+                              EventKinematics const &kin) {
+  return GetEventResponseFromFill(ev, kin);
+}
+
+void BeRPAWeight::FillEventResponse(
+    [[maybe_unused]] genie::EventRecord const &ev, EventKinematics const &kin,
+    ResponseBuffer &buf) {
 
-  event_unit_response_t resp;
   SystMetaData const &md = GetSystMetaData();
 
-  if (!ev.Summary()->ProcInfo().IsQuasiElastic() ||
-      !ev.Summary()->ProcInfo().IsWeakCC() ||
-      ev.Summary()->ExclTag().IsCharmEvent()) {
-    return resp;
+  if ((kin.mode != simb_mode_copy::kQE) || !kin.is_cc || kin.is_charm) {
+    return;
   }
 
 #ifdef BERPAWEIGHT_DEBUG
@@ -175,16 +184,11 @@ BeRPAWeight::GetEventResponse(genie::EventRecord const &ev) {
     std::cout << "[INFO]: QE event with high W (NEUT: "
               << genie::utils::ghep::NeutReactionCode(&ev) << ") " << std::endl
               << DumpGENIEEv(ev) << std::endl;
-    return resp;
+    return;
   }
 #endif
 
-  genie::GHepParticle *FSLep = ev.FinalStatePrimaryLepton();
-  genie::GHepParticle *ISLep = ev.Probe();
-  TLorentzVector FSLepP4 = *FSLep->P4();
-  TLorentzVector ISLepP4 = *ISLep->P4();
-  TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
-  Q2 = -emTransfer.Mag2();
+  Q2 = kin.Q2_GeV2;
 
   // Only want the CV response to be used in one of the dials, after the first
   // dial is found, all other dial responses should be /= CVResponse.
@@ -196,8 +200,12 @@ BeRPAWeight::GetEventResponse(genie::EventRecord const &ev) {
             << ECV << "] = " << CVResponse << std::endl;
 #endif
 
+  // Filled responses, for the validation tree.
+  double const *filled[4] = {nullptr, nullptr, nullptr, nullptr};
+
   if (!ignore_parameter_dependence) {
-    resp.push_back({md[pidx_BeRPA_Response].systParamId, {}});
+    double *out = buf.Fill(md[pidx_BeRPA_Response].systParamId);
+    filled[0] = out;
 
     for (size_t univ = 0; univ < md[pidx_BeRPA_Response].paramVariations.size();
          ++univ) {
@@ -213,14 +221,16 @@ BeRPAWeight::GetEventResponse(genie::EventRecord const &ev) {
         weight /= CVResponse;
       }
 
-      resp.back().responses.push_back(weight);
+      out[univ] = weight;
     }
   } else {
 
     bool UsedADial = false;
     if (pidx_BeRPA_A != kParamUnhandled<size_t>) {
-      resp.push_back({md[pidx_BeRPA_A].systParamId, {}});
-      for (double av : AVariations) {
+      double *out = buf.Fill(md[pidx_BeRPA_A].systParamId);
+      filled[0] = out;
+      for (size_t v_it = 0; v_it < AVariations.size(); ++v_it) {
+        double av = AVariations[v_it];
         double weight = GetBeRPAWeight(e2i(simb_mode_copy::kQE), true, Q2, av,
                                        BCV, DCV, ECV);
 #ifdef BERPAWEIGHT_DEBUG
@@ -230,13 +240,15 @@ BeRPAWeight::GetEventResponse(genie::EventRecord const &ev) {
         if (!ApplyCV) {
           weight /= CVResponse;
         }
-        resp.back().responses.push_back(weight);
+        out[v_it] = weight;
       }
       UsedADial = true;
     }
     if (pidx_BeRPA_B != kParamUnhandled<size_t>) {
-      resp.push_back({md[pidx_BeRPA_B].systParamId, {}});
-      for (double bv : BVariations) {
+      double *out = buf.Fill(md[pidx_BeRPA_B].systParamId);
+      filled[1] = out;
+      for (size_t v_it = 0; v_it < BVariations.size(); ++v_it) {
+        double bv = BVariations[v_it];
         double weight = GetBeRPAWeight(e2i(simb_mode_copy::kQE), true, Q2, ACV,
                                        bv, DCV, ECV);
 #ifdef BERPAWEIGHT_DEBUG
@@ -246,13 +258,15 @@ BeRPAWeight::GetEventResponse(genie::EventRecord const &ev) {
         if (!ApplyCV || UsedADial) {
           weight /= CVResponse;
         }
-        resp.back().responses.push_back(weight);
+        out[v_it] = weight;
       }
       UsedADial = true;
     }
     if (pidx_BeRPA_D != kParamUnhandled<size_t>) {
-      resp.push_back({md[pidx_BeRPA_D].systParamId, {}});
-      for (double dv : DVariations) {
+      double *out = buf.Fill(md[pidx_BeRPA_D].systParamId);
+      filled[2] = out;
+      for (size_t v_it = 0; v_it < DVariations.size(); ++v_it) {
+        double dv = DVariations[v_it];
         double weight = GetBeRPAWeight(e2i(simb_mode_copy::kQE), true, Q2, ACV,
                                        BCV, dv, ECV);
 #ifdef BERPAWEIGHT_DEBUG
@@ -262,13 +276,15 @@ BeRPAWeight::GetEventResponse(genie::EventRecord const &ev) {
         if (!ApplyCV || UsedADial) {
           weight /= CVResponse;
         }
-        resp.back().responses.push_back(weight);
+        out[v_it] = weight;
       }
       UsedADial = true;
     }
     if (pidx_BeRPA_E != kParamUnhandled<size_t>) {
-      resp.push_back({md[pidx_BeRPA_E].systParamId, {}});
-      for (double eval : EVariations) {
+      double *out = buf.Fill(md[pidx_BeRPA_E].systParamId);
+      filled[3] = out;
+      for (size_t v_it = 0; v_it < EVariations.size(); ++v_it) {
+        double eval = EVariations[v_it];
         double weight = GetBeRPAWeight(e2i(simb_mode_copy::kQE), true, Q2, ACV,
                                        BCV, DCV, eval);
 #ifdef BERPAWEIGHT_DEBUG
@@ -278,35 +294,33 @@ BeRPAWeight::GetEventResponse(genie::EventRecord const &ev) {
         if (!ApplyCV || UsedADial) {
           weight /= CVResponse;
         }
-        resp.back().responses.push_back(weight);
+        out[v_it] = weight;
       }
     }
   }
 
   if (fill_valid_tree) {
-
-    int Pdgnu = ISLep->Pdg();
-
-    NEUTMode = 0;
-    if (ev.Summary()->ProcInfo().IsMEC() &&
-        ev.Summary()->ProcInfo().IsWeakCC()) {
-      NEUTMode = (Pdgnu > 0) ? 2 : -2;
-    } else {
-      NEUTMode = genie::utils::ghep::NeutReactionCode(&ev);
-    }
-
-    Enu = ISLepP4.E();
+    NEUTMode = kin.NEUTMode();
+    Enu = kin.Enu_GeV;
     weight = 1;
 
-    for (auto const &eur : resp) {
-      weight *= eur.responses[3];
+    for (double const *out : filled) {
+      if (out) {
+        weight *= out[3];
+      }
     }
 
     valid_tree->Fill();
   }
+}
+InteractionMask BeRPAWeight::GetApplicability() {
+  return InteractionMask().Add(simb_mode_copy::kQE, InteractionMask::kCC);
+}
 
-  return resp;
+std::unique_ptr<IGENIESystProvider_tool> BeRPAWeight::Clone() const {
+  return std::make_unique<BeRPAWeight>(*this);
 }
+
 std::string BeRPAWeight::AsString() { return "BeRPAWeight"; }
 
 void BeRPAWeight::InitValidTree() {
@@ -3,6 +3,8 @@
 
 #include "nusystematics/interface/IGENIESystProvider_tool.hh"
 
+#include "nusystematics/utility/InstanceLocal.hh"
+
 #include "TFile.h"
 #include "TTree.h"
 
@@ -21,6 +23,16 @@ public:
                                             systtools::paramId_t);
 
   systtools::event_unit_response_t GetEventResponse(genie::EventRecord const &);
+  systtools::event_unit_response_t
+  GetEventResponse(genie::EventRecord const &,
+                   nusyst::EventKinematics const &);
+  void FillEventResponse(genie::EventRecord const &,
+                         nusyst::EventKinematics const &,
+                         nusyst::ResponseBuffer &);
+
+  nusyst::InteractionMask GetApplicability();
+
+  std::unique_ptr<nusyst::IGENIESystProvider_tool> Clone() const;
 
   std::string AsString();
 
@@ -41,9 +53,10 @@ private:
 
   void InitValidTree();
 
-  bool fill_valid_tree;
-  TFile *valid_file;
-  TTree *valid_tree;
+  // The validation tree and its branch addresses belong to this instance.
+  nusyst::InstanceLocal<bool> fill_valid_tree;
+  nusyst::InstanceLocal<TFile *> valid_file;
+  nusyst::InstanceLocal<TTree *> valid_tree;
 
   int NEUTMode;
   double Enu, Q2, weight;
@@ -80,7 +80,12 @@ bool EbLepMomShift::SetupResponseCalculator(
 
   ResponseParameterIdx = GetParamIndex(md, "EbFSLepMomShift");
 
-  EbTemplate.LoadInputHistograms(templateManifest);
+  std::shared_ptr<EbTemplateResponseEnuFSLepctheta> tmpl =
+      std::make_shared<EbTemplateResponseEnuFSLepctheta>();
+  tmpl->LoadInputHistograms(templateManifest);
+  EbTemplate = std::move(tmpl);
+  VariationSlots = EbTemplate->ResolveVariationIndices(
+      md[ResponseParameterIdx].paramVariations);
 
   fill_valid_tree = tool_options.get("fill_valid_tree", false);
 
@@ -93,58 +98,89 @@ bool EbLepMomShift::SetupResponseCalculator(
 
 event_unit_response_t
 EbLepMomShift::GetEventResponse(genie::EventRecord const &ev) {
+  return GetEventResponse(ev, EventKinematics(ev));
+}
+
+event_unit_response_t
+EbLepMomShift::GetEventResponse(genie::EventRecord const &,
+                                EventKinematics const &kin) {
 
   event_unit_response_t resp;
   SystMetaData const &md = GetSystMetaData();
 
-  if (!ev.Summary()->ProcInfo().IsQuasiElastic() ||
-      !ev.Summary()->ProcInfo().IsWeakCC() || ev.Summary()->ExclTag().IsCharmEvent()) {
+  if ((kin.mode != simb_mode_copy::kQE) || !kin.is_cc || kin.is_charm) {
     return resp;
   }
 
-  genie::GHepParticle *FSLep = ev.FinalStatePrimaryLepton();
-  genie::GHepParticle *ISLep = ev.Probe();
-  TLorentzVector FSLepP4 = *FSLep->P4();
-  TLorentzVector ISLepP4 = *ISLep->P4();
-
-  Enu = ISLepP4.E();
-  FSLep_ctheta = FSLepP4.Vect().CosTheta();
-
-  int bin = EbTemplate.GetBin({{Enu, FSLep_ctheta}});
-  if (bin != kBinOutsideRange) {
-    resp.push_back({md[ResponseParameterIdx].systParamId, {}});
-    for (double v : md[ResponseParameterIdx].paramVariations) {
-      if ((v == 0) && !EbTemplate.IsValidVariation(0)) {
-        resp.back().responses.push_back(0);
-      } else {
-        resp.back().responses.push_back(
-            EbTemplate.GetVariation(v, {{Enu, FSLep_ctheta}}));
-      }
-    }
+  std::vector<double> responses(
+      md[ResponseParameterIdx].paramVariations.size());
+  bool InRange = CalcResponses(kin, responses.data());
+  if (InRange) {
+    resp.push_back(
+        {md[ResponseParameterIdx].systParamId, std::move(responses)});
   }
 
   if (fill_valid_tree) {
-
-    int Pdgnu = ISLep->Pdg();
-
-    NEUTMode = 0;
-    if (ev.Summary()->ProcInfo().IsMEC() &&
-        ev.Summary()->ProcInfo().IsWeakCC()) {
-      NEUTMode = (Pdgnu > 0) ? 2 : -2;
-    } else {
-      NEUTMode = genie::utils::ghep::NeutReactionCode(&ev);
-    }
-
-    FSLep_pmu = FSLepP4.Vect().Mag();
+    NEUTMode = kin.NEUTMode();
+    Enu = kin.Enu_GeV;
+    FSLep_ctheta = kin.FSLepP4.Vect().CosTheta();
+    FSLep_pmu = kin.FSLepP4.Vect().Mag();
     shift = resp.front().responses[3];
 
-    BinOutsideRange = (bin == kBinOutsideRange);
+    BinOutsideRange = !InRange;
 
     valid_tree->Fill();
   }
 
   return resp;
 }
+
+void EbLepMomShift::FillEventResponse(genie::EventRecord const &ev,
+                                      EventKinematics const &kin,
+                                      ResponseBuffer &buf) {
+  if (fill_valid_tree) {
+    IGENIESystProvider_tool::FillEventResponse(ev, kin, buf);
+    return;
+  }
+
+  paramId_t pid = GetSystMetaData()[ResponseParameterIdx].systParamId;
+  if (CalcResponses(kin, buf.GetWriteBuffer(pid))) {
+    buf.SetFilled(pid);
+  }
+}
+
+bool EbLepMomShift::CalcResponses(EventKinematics const &kin, double *out) {
+  if ((kin.mode != simb_mode_copy::kQE) || !kin.is_cc || kin.is_charm) {
+    return false;
+  }
+
+  std::array<double, 2> kinematics{{kin.Enu_GeV,
+                                    kin.FSLepP4.Vect().CosTheta()}};
+
+  EbTemplateResponseEnuFSLepctheta::bin_it_t bin =
+      EbTemplate->GetBin(kinematics);
+  if (bin == kBinOutsideRange) {
+    return false;
+  }
+
+  for (size_t v_it = 0; v_it < VariationSlots.size(); ++v_it) {
+    if (VariationSlots[v_it] == EbTemplateResponseEnuFSLepctheta::kNoSlot) {
+      out[v_it] = 0;
+    } else {
+      out[v_it] = EbTemplate->GetVariationByIndex(VariationSlots[v_it], bin);
+    }
+  }
+  return true;
+}
+
+InteractionMask EbLepMomShift::GetApplicability() {
+  return InteractionMask().Add(simb_mode_copy::kQE, InteractionMask::kCC);
+}
+
+std::unique_ptr<IGENIESystProvider_tool> EbLepMomShift::Clone() const {
+  return std::make_unique<EbLepMomShift>(*this);
+}
+
 std::string EbLepMomShift::AsString() { return "EbLepMomShift"; }
 
 void EbLepMomShift::InitValidTree() {
@@ -3,6 +3,8 @@
 
 #include "nusystematics/interface/IGENIESystProvider_tool.hh"
 
+#include "nusystematics/utility/InstanceLocal.hh"
+
 #include "nusystematics/responsecalculators/TemplateResponseCalculatorBase.hh"
 
 #include "TFile.h"
@@ -31,6 +33,16 @@ public:
                                             systtools::paramId_t);
 
   systtools::event_unit_response_t GetEventResponse(genie::EventRecord const &);
+  systtools::event_unit_response_t
+  GetEventResponse(genie::EventRecord const &,
+                   nusyst::EventKinematics const &);
+  void FillEventResponse(genie::EventRecord const &,
+                         nusyst::EventKinematics const &,
+                         nusyst::ResponseBuffer &);
+
+  nusyst::InteractionMask GetApplicability();
+
+  std::unique_ptr<nusyst::IGENIESystProvider_tool> Clone() const;
 
   std::string AsString();
 
@@ -41,13 +53,20 @@ private:
 
   size_t ResponseParameterIdx;
 
-  EbTemplateResponseEnuFSLepctheta EbTemplate;
+  std::shared_ptr<EbTemplateResponseEnuFSLepctheta const> EbTemplate;
+  /// Template slot of each parameter variation
+  std::vector<size_t> VariationSlots;
+
+  /// Writes one response per parameter variation to out, returns false
+  /// without writing if the event is unaffected or outside of the template.
+  bool CalcResponses(nusyst::EventKinematics const &, double *out);
 
   void InitValidTree();
 
-  bool fill_valid_tree;
-  TFile *valid_file;
-  TTree *valid_tree;
+  // The validation tree and its branch addresses belong to this instance.
+  nusyst::InstanceLocal<bool> fill_valid_tree;
+  nusyst::InstanceLocal<TFile *> valid_file;
+  nusyst::InstanceLocal<TTree *> valid_tree;
 
   int NEUTMode;
   double Enu, FSLep_pmu, FSLep_ctheta, shift;
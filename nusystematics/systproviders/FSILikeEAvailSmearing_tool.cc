@@ -138,11 +138,15 @@ bool FSILikeEAvailSmearing::SetupResponseCalculator(
       continue;
     }
 
+    std::shared_ptr<FSILikeEAvailSmearing_ReWeight> tmpl =
+        std::make_shared<FSILikeEAvailSmearing_ReWeight>();
+    tmpl->LoadInputHistograms(InheritTemplateBankOptions(
+        templateManifest, templateManifest.get<fhicl::ParameterSet>(ch.name)));
+
     TemplateHelper th;
-    th.Template = std::make_unique<FSILikeEAvailSmearing_ReWeight>();
-    th.Template->LoadInputHistograms(
-        templateManifest.get<fhicl::ParameterSet>(ch.name));
-    th.ZeroIsValid = th.Template->IsValidVariation(0);
+    th.Template = std::move(tmpl);
+    th.VariationSlots = th.Template->ResolveVariationIndices(
+        GetSystMetaData()[ResponseParameterIdx].paramVariations);
 
     ChannelParameterMapping.emplace(ch.channel, std::move(th));
   }
@@ -187,59 +191,126 @@ FSILikeEAvailSmearing::chan GetChan(simb_mode_copy mode, bool IsCC, bool IsNu) {
 
 event_unit_response_t
 FSILikeEAvailSmearing::GetEventResponse(genie::EventRecord const &ev) {
+  return GetEventResponse(ev, EventKinematics(ev));
+}
+
+event_unit_response_t
+FSILikeEAvailSmearing::GetEventResponse(genie::EventRecord const &,
+                                        EventKinematics const &kin) {
 
   event_unit_response_t resp;
 
-  // Ignore Coherent
-  simb_mode_copy mode = GetSimbMode(ev);
-  if (mode == simb_mode_copy::kCoh) {
-    return resp;
+  SystParamHeader const &hdr = GetSystMetaData()[ResponseParameterIdx];
+
+  std::vector<double> responses(hdr.paramVariations.size());
+  if (CalcResponses(kin, responses.data())) {
+    resp.push_back({hdr.systParamId, std::move(responses)});
   }
+  return resp;
+}
 
-  genie::GHepParticle *FSLep = ev.FinalStatePrimaryLepton();
-  genie::GHepParticle *ISLep = ev.Probe();
+void FSILikeEAvailSmearing::FillEventResponse(genie::EventRecord const &,
+                                              EventKinematics const &kin,
+                                              ResponseBuffer &buf) {
+  paramId_t pid = GetSystMetaData()[ResponseParameterIdx].systParamId;
+  if (CalcResponses(kin, buf.GetWriteBuffer(pid))) {
+    buf.SetFilled(pid);
+  }
+}
 
-  if (!FSLep || !ISLep) {
-    throw incorrectly_generated()
-        << "[ERROR]: Failed to find IS and FS lepton in event: "
-        << ev.Summary()->AsString();
+bool FSILikeEAvailSmearing::CalcResponses(EventKinematics const &kin,
+                                          double *out) {
+  // Ignore Coherent
+  if (kin.mode == simb_mode_copy::kCoh) {
+    return false;
   }
 
-  chan evch =
-      GetChan(mode, ev.Summary()->ProcInfo().IsWeakCC(), ISLep->Pdg() > 0);
+  chan evch = GetChan(kin.mode, kin.is_cc, kin.nu_pdg > 0);
 
-  if (ChannelParameterMapping.find(evch) == ChannelParameterMapping.end()) {
-    return resp;
+  auto ch_it = ChannelParameterMapping.find(evch);
+  if (ch_it == ChannelParameterMapping.end()) {
+    return false;
   }
 
   SystParamHeader const &hdr = GetSystMetaData()[ResponseParameterIdx];
 
-  TLorentzVector FSLepP4 = *FSLep->P4();
-  TLorentzVector ISLepP4 = *ISLep->P4();
-
-  TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
-
   std::array<double, 3> kinematics;
-  kinematics[0] = emTransfer.Vect().Mag();
-  kinematics[1] = emTransfer[3];
-  kinematics[2] = GetErecoil_MINERvA_LowRecoil(ev) / kinematics[1];
-
-  resp.push_back({hdr.systParamId, {}});
-  for (double val : hdr.paramVariations) {
-
-    if ((val == 0) && !ChannelParameterMapping[evch].ZeroIsValid) {
-      resp.back().responses.push_back(1);
+  kinematics[0] = kin.q3_GeV;
+  kinematics[1] = kin.q0_GeV;
+  kinematics[2] = kin.EAvail_GeV() / kinematics[1];
+
+  // Every variation is read from the same template bin.
+  FSILikeEAvailSmearing_ReWeight::bin_it_t bin =
+      ch_it->second.Template->GetBin(kinematics);
+
+  TemplateHelper const &th = ch_it->second;
+  size_t NVars = hdr.paramVariations.size();
+  for (size_t v_it = 0; v_it < NVars; ++v_it) {
+    if (th.VariationSlots[v_it] == FSILikeEAvailSmearing_ReWeight::kNoSlot) {
+      out[v_it] = 1;
     } else {
       double wght =
-          ChannelParameterMapping[evch].Template->GetVariation(val, kinematics);
+          th.Template->GetVariationByIndex(th.VariationSlots[v_it], bin);
 
       wght = (wght < LimitWeights.first) ? LimitWeights.first : wght;
       wght = (wght > LimitWeights.second) ? LimitWeights.second : wght;
 
-      resp.back().responses.push_back(wght);
+      out[v_it] = wght;
     }
   }
-  return resp;
+  return true;
+}
+
+InteractionMask FSILikeEAvailSmearing::GetApplicability() {
+  InteractionMask mask;
+  for (auto const &ch : ChannelParameterMapping) {
+    switch (ch.first) {
+    case chan::kCCQE:
+    case chan::kCCQE_bar: {
+      mask.Add(simb_mode_copy::kQE, InteractionMask::kCC,
+               (ch.first == chan::kCCQE) ? InteractionMask::kNu
+                                         : InteractionMask::kNuBar);
+      break;
+    }
+    case chan::kCCRes:
+    case chan::kCCRes_bar: {
+      mask.Add(simb_mode_copy::kRes, InteractionMask::kCC,
+               (ch.first == chan::kCCRes) ? InteractionMask::kNu
+                                          : InteractionMask::kNuBar);
+      break;
+    }
+    case chan::kCCDIS:
+    case chan::kCCDIS_bar: {
+      mask.Add(simb_mode_copy::kDIS, InteractionMask::kCC,
+               (ch.first == chan::kCCDIS) ? InteractionMask::kNu
+                                          : InteractionMask::kNuBar);
+      break;
+    }
+    case chan::kCCMEC:
+    case chan::kCCMEC_bar: {
+      mask.Add(simb_mode_copy::kMEC, InteractionMask::kCC,
+               (ch.first == chan::kCCMEC) ? InteractionMask::kNu
+                                          : InteractionMask::kNuBar);
+      break;
+    }
+    case chan::kNC: {
+      // Coherent events are ignored
+      for (int m = e2i(simb_mode_copy::kUnknownInteraction);
+           m <= e2i(simb_mode_copy::kWeakMix); ++m) {
+        if (m != e2i(simb_mode_copy::kCoh)) {
+          mask.Add(static_cast<simb_mode_copy>(m), InteractionMask::kNC);
+        }
+      }
+      break;
+    }
+    default: {}
+    }
+  }
+  return mask;
+}
+
+std::unique_ptr<IGENIESystProvider_tool> FSILikeEAvailSmearing::Clone() const {
+  return std::make_unique<FSILikeEAvailSmearing>(*this);
 }
 
 std::string FSILikeEAvailSmearing::AsString() { return ""; }
@@ -32,8 +32,9 @@ public:
 
 private:
   struct TemplateHelper {
-    std::unique_ptr<nusyst::FSILikeEAvailSmearing_ReWeight> Template;
-    bool ZeroIsValid;
+    std::shared_ptr<nusyst::FSILikeEAvailSmearing_ReWeight const> Template;
+    /// Template slot of each parameter variation
+    std::vector<size_t> VariationSlots;
   };
 
   std::map<chan, TemplateHelper> ChannelParameterMapping;
@@ -49,6 +50,16 @@ public:
                                             systtools::paramId_t);
 
   systtools::event_unit_response_t GetEventResponse(genie::EventRecord const &);
+  systtools::event_unit_response_t
+  GetEventResponse(genie::EventRecord const &,
+                   nusyst::EventKinematics const &);
+  void FillEventResponse(genie::EventRecord const &,
+                         nusyst::EventKinematics const &,
+                         nusyst::ResponseBuffer &);
+
+  nusyst::InteractionMask GetApplicability();
+
+  std::unique_ptr<nusyst::IGENIESystProvider_tool> Clone() const;
 
   std::string AsString();
 
@@ -56,6 +67,10 @@ public:
 
 private:
   fhicl::ParameterSet tool_options;
+
+  /// Writes one response per parameter variation to out, returns false
+  /// without writing if the event is unaffected.
+  bool CalcResponses(nusyst::EventKinematics const &, double *out);
 };
 
 #endif
@@ -1,6 +1,9 @@
 #include "nusystematics/systproviders/GENIEReWeightEngineConfig.hh"
 
+#include "nusystematics/utility/ScopedTH1AddDirectory.hh"
+
 // GENIE
+#include "Framework/Conventions/Controls.h"
 #include "Framework/GHEP/GHepParticle.h"
 #include "RwCalculators/GReWeightAGKY.h"
 #include "RwCalculators/GReWeightFGM.h"
@@ -18,17 +21,418 @@
 #include "RwCalculators/GReWeightNuXSecNCRES.h"
 #include "RwCalculators/GReWeightResonanceDecay.h"
 #include "RwCalculators/GReWeightDeltaradAngle.h"
+#include "RwFramework/GSystUncertainty.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <functional>
+#include <mutex>
 
 using namespace systtools;
 using namespace genie::rew;
 
 namespace nusyst {
 
+GSystApplicability GetGSystApplicability(GSyst_t gdial) {
+  typedef InteractionMask IM;
+  typedef GSystApplicability GA;
+  switch (gdial) {
+  case kXSecTwkDial_NormCCQE:
+  case kXSecTwkDial_MaCCQE:
+  case kXSecTwkDial_MaCCQEshape:
+  case kXSecTwkDial_AxFFCCQEshape:
+  case kXSecTwkDial_ZNormCCQE:
+  case kXSecTwkDial_ZExpA1CCQE:
+  case kXSecTwkDial_ZExpA2CCQE:
+  case kXSecTwkDial_ZExpA3CCQE:
+  case kXSecTwkDial_ZExpA4CCQE:
+  case kXSecTwkDial_VecFFCCQEshape:
+  case kXSecTwkDial_RPA_CCQE:
+  case kXSecTwkDial_CoulombCCQE: {
+    return {IM().Add(simb_mode_copy::kQE, IM::kCC), GA::kNoHadronRequirement};
+  }
+  case kXSecTwkDial_MaNCEL:
+  case kXSecTwkDial_EtaNCEL: {
+    return {IM().Add(simb_mode_copy::kQE, IM::kNC), GA::kNoHadronRequirement};
+  }
+  case kXSecTwkDial_NormCCMEC:
+  case kXSecTwkDial_NormNCMEC:
+  case kXSecTwkDial_NormEMMEC:
+  case kXSecTwkDial_DecayAngMEC:
+  case kXSecTwkDial_FracPN_CCMEC:
+  case kXSecTwkDial_FracDelta_CCMEC:
+  case kXSecTwkDial_XSecShape_CCMEC: {
+    return {IM().Add(simb_mode_copy::kMEC), GA::kNoHadronRequirement};
+  }
+  case kXSecTwkDial_NormCCRES:
+  case kXSecTwkDial_MaCCRES:
+  case kXSecTwkDial_MvCCRES:
+  case kXSecTwkDial_MaCCRESshape:
+  case kXSecTwkDial_MvCCRESshape: {
+    return {IM().Add(simb_mode_copy::kRes, IM::kCC),
+            GA::kNoHadronRequirement};
+  }
+  case kXSecTwkDial_NormNCRES:
+  case kXSecTwkDial_MaNCRES:
+  case kXSecTwkDial_MvNCRES:
+  case kXSecTwkDial_MaNCRESshape:
+  case kXSecTwkDial_MvNCRESshape: {
+    return {IM().Add(simb_mode_copy::kRes, IM::kNC),
+            GA::kNoHadronRequirement};
+  }
+  case kRDcyTwkDial_BR1gamma:
+  case kRDcyTwkDial_BR1eta:
+  case kRDcyTwkDial_Theta_Delta2Npi:
+  case kRDcyTwkDial_Theta_Delta2NRad: {
+    return {IM().Add(simb_mode_copy::kRes), GA::kNoHadronRequirement};
+  }
+  case kXSecTwkDial_MaCOHpi:
+  case kXSecTwkDial_R0COHpi:
+  case kXSecTwkDial_NormCCCOHpi:
+  case kXSecTwkDial_NormNCCOHpi: {
+    return {IM().Add(simb_mode_copy::kCoh), GA::kNoHadronRequirement};
+  }
+  // The non-resonant background and AGKY dials only act on the low-W part of
+  // GENIE's DIS, which is left to the calculators.
+  case kXSecTwkDial_RvpCC1pi:
+  case kXSecTwkDial_RvpCC2pi:
+  case kXSecTwkDial_RvnCC1pi:
+  case kXSecTwkDial_RvnCC2pi:
+  case kXSecTwkDial_RvbarpCC1pi:
+  case kXSecTwkDial_RvbarpCC2pi:
+  case kXSecTwkDial_RvbarnCC1pi:
+  case kXSecTwkDial_RvbarnCC2pi: {
+    return {IM().Add(simb_mode_copy::kDIS, IM::kCC),
+            GA::kNoHadronRequirement};
+  }
+  case kXSecTwkDial_RvpNC1pi:
+  case kXSecTwkDial_RvpNC2pi:
+  case kXSecTwkDial_RvnNC1pi:
+  case kXSecTwkDial_RvnNC2pi:
+  case kXSecTwkDial_RvbarpNC1pi:
+  case kXSecTwkDial_RvbarpNC2pi:
+  case kXSecTwkDial_RvbarnNC1pi:
+  case kXSecTwkDial_RvbarnNC2pi: {
+    return {IM().Add(simb_mode_copy::kDIS, IM::kNC),
+            GA::kNoHadronRequirement};
+  }
+  case kXSecTwkDial_AhtBY:
+  case kXSecTwkDial_BhtBY:
+  case kXSecTwkDial_CV1uBY:
+  case kXSecTwkDial_CV2uBY:
+  case kXSecTwkDial_AhtBYshape:
+  case kXSecTwkDial_BhtBYshape:
+  case kXSecTwkDial_CV1uBYshape:
+  case kXSecTwkDial_CV2uBYshape:
+  case kHadrAGKYTwkDial_xF1pi:
+  case kHadrAGKYTwkDial_pT1pi: {
+    return {IM().Add(simb_mode_copy::kDIS), GA::kNoHadronRequirement};
+  }
+  case kHadrNuclTwkDial_FormZone: {
+    return {IM::All(), GA::kHadronInNucleus};
+  }
+  case kINukeTwkDial_MFP_pi:
+  case kINukeTwkDial_FrCEx_pi:
+  case kINukeTwkDial_FrInel_pi:
+  case kINukeTwkDial_FrAbs_pi:
+  case kINukeTwkDial_FrPiProd_pi: {
+    return {IM::All(), GA::kPionInNucleus};
+  }
+  case kINukeTwkDial_MFP_N:
+  case kINukeTwkDial_FrCEx_N:
+  case kINukeTwkDial_FrInel_N:
+  case kINukeTwkDial_FrAbs_N:
+  case kINukeTwkDial_FrPiProd_N: {
+    return {IM::All(), GA::kNucleonInNucleus};
+  }
+  // Anything not listed is never filtered.
+  default: { return {IM::All(), GA::kNoHadronRequirement}; }
+  }
+}
+
+std::unique_ptr<GReWeight> BuildWeightEngine(GReWeightEngineSpec const &spec,
+                                             double *build_seconds) {
+  // Shared by every tool instance, as instances on different threads may
+  // build engines at the same time, e.g. when choosing a hybrid HERG layout.
+  static std::mutex genie_algorithm_mutex;
+
+  // Calculator constructors register algorithms with the GENIE AlgFactory
+  // and book the histograms they weight with, which must be owned by the
+  // current directory. Reconfigure then configures the calculators' models
+  // through the AlgFactory and AlgConfigPool, whose lookups and insertions
+  // are not thread-safe. As these calls are spread through the GENIE
+  // calculators, the whole build is serialized.
+  std::lock_guard<std::mutex> lock(genie_algorithm_mutex);
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  std::unique_ptr<GReWeight> grw;
+  {
+    ScopedTH1AddDirectory add_directory;
+    grw = std::make_unique<GReWeight>();
+    for (GReWeightCalcSpec const &calc : spec.calcs) {
+      grw->AdoptWghtCalc(calc.name, calc.instantiate());
+    }
+  }
+  for (auto const &dial_value : spec.dial_values) {
+    grw->Systematics().Init(dial_value.first, dial_value.second);
+  }
+  grw->Reconfigure();
+  if (build_seconds) {
+    *build_seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+  }
+  return grw;
+}
+
+std::vector<std::shared_ptr<SharedGReWeight>>
+BuildSharedWeightEngines(std::vector<GReWeightEngineRequest> const &requests,
+                         GReWeightEnginePool &pool,
+                         std::vector<double> *build_seconds) {
+
+  std::vector<std::shared_ptr<SharedGReWeight>> engines(requests.size());
+
+  // Requests that need a new engine, and those that share one with an
+  // earlier request.
+  struct EngineJob {
+    size_t req_idx;
+    std::string pool_key;
+  };
+  struct EngineAlias {
+    size_t req_idx;
+    size_t job_idx;
+  };
+  std::vector<EngineJob> jobs;
+  std::vector<EngineAlias> aliases;
+  std::map<std::string, size_t> job_keys;
+
+  for (size_t r_it = 0; r_it < requests.size(); ++r_it) {
+    if (!requests[r_it].shareable) {
+      jobs.push_back({r_it, ""});
+      continue;
+    }
+    std::string key = requests[r_it].spec->GetPoolKey();
+    std::shared_ptr<SharedGReWeight> pooled;
+    GReWeightEnginePool::iterator pool_it = pool.find(key);
+    if (pool_it != pool.end()) {
+      pooled = pool_it->second.lock();
+    }
+    if (pooled) {
+      engines[r_it] = pooled;
+    } else if (job_keys.count(key)) {
+      aliases.push_back({r_it, job_keys[key]});
+    } else {
+      job_keys[key] = jobs.size();
+      jobs.push_back({r_it, key});
+    }
+  }
+
+  if (build_seconds) {
+    build_seconds->assign(requests.size(), 0);
+  }
+
+  for (EngineJob const &job : jobs) {
+    std::shared_ptr<SharedGReWeight> grw = std::make_shared<SharedGReWeight>();
+    grw->engine = BuildWeightEngine(
+        *requests[job.req_idx].spec,
+        build_seconds ? &(*build_seconds)[job.req_idx] : nullptr);
+    engines[job.req_idx] = std::move(grw);
+  }
+
+  for (EngineJob const &job : jobs) {
+    if (job.pool_key.size()) {
+      pool[job.pool_key] = engines[job.req_idx];
+    }
+  }
+  for (EngineAlias const &alias : aliases) {
+    engines[alias.req_idx] = engines[jobs[alias.job_idx].req_idx];
+  }
+  return engines;
+}
+
+std::vector<double>
+BuildWeightEngines(SystMetaData const &md,
+                   std::vector<GENIEResponseParameter> &param_map,
+                   GReWeightEnginePool &pool) {
+
+  std::vector<GReWeightEngineRequest> requests;
+  std::vector<std::pair<size_t, size_t>> request_slots;
+
+  for (size_t p_it = 0; p_it < param_map.size(); ++p_it) {
+    GENIEResponseParameter &par = param_map[p_it];
+    if (par.Herg.size() == par.HergSpecs.size()) {
+      continue;
+    }
+    par.Herg.clear();
+    par.FrontEngineDialValues.clear();
+    par.Herg.resize(par.HergSpecs.size());
+
+    // The single engine of a reduced parameter is reconfigured for every
+    // variation, so cannot be shared.
+    size_t NVars =
+        md[par.pidx].isCorrection ? 1 : md[par.pidx].paramVariations.size();
+    bool CanShare = (par.HergSpecs.size() >= NVars);
+
+    for (size_t s_it = 0; s_it < par.HergSpecs.size(); ++s_it) {
+      requests.push_back({&par.HergSpecs[s_it], CanShare});
+      request_slots.emplace_back(p_it, s_it);
+    }
+  }
+
+  std::vector<double> request_seconds;
+  std::vector<std::shared_ptr<SharedGReWeight>> engines =
+      BuildSharedWeightEngines(requests, pool, &request_seconds);
+
+  std::vector<double> par_seconds(param_map.size(), 0);
+  for (size_t r_it = 0; r_it < requests.size(); ++r_it) {
+    size_t p_it = request_slots[r_it].first;
+    param_map[p_it].Herg[request_slots[r_it].second] = std::move(engines[r_it]);
+    par_seconds[p_it] += request_seconds[r_it];
+  }
+  for (size_t r_it = 0; r_it < requests.size(); ++r_it) {
+    if (!r_it || (request_slots[r_it].first != request_slots[r_it - 1].first)) {
+      param_map[request_slots[r_it].first].IndexSharedEngines();
+    }
+  }
+  return par_seconds;
+}
+
+bool IsAnalyticNormDial(GSyst_t gdial) {
+  switch (gdial) {
+  case kXSecTwkDial_NormCCQE:
+  case kXSecTwkDial_NormCCRES:
+  case kXSecTwkDial_NormNCRES:
+  case kXSecTwkDial_RvpCC1pi:
+  case kXSecTwkDial_RvpCC2pi:
+  case kXSecTwkDial_RvpNC1pi:
+  case kXSecTwkDial_RvpNC2pi:
+  case kXSecTwkDial_RvnCC1pi:
+  case kXSecTwkDial_RvnCC2pi:
+  case kXSecTwkDial_RvnNC1pi:
+  case kXSecTwkDial_RvnNC2pi:
+  case kXSecTwkDial_RvbarpCC1pi:
+  case kXSecTwkDial_RvbarpCC2pi:
+  case kXSecTwkDial_RvbarpNC1pi:
+  case kXSecTwkDial_RvbarpNC2pi:
+  case kXSecTwkDial_RvbarnCC1pi:
+  case kXSecTwkDial_RvbarnCC2pi:
+  case kXSecTwkDial_RvbarnNC1pi:
+  case kXSecTwkDial_RvbarnNC2pi: {
+    return true;
+  }
+  default: { return false; }
+  }
+}
+
+namespace {
+// Upper W limit of GReWeightNonResonanceBkg
+constexpr double kNonResBkgWmin_GeV = 2;
+
+struct NonResBkgChannel {
+  bool is_nu;
+  bool is_proton;
+  bool is_cc;
+  size_t NPi;
+};
+
+NonResBkgChannel GetNonResBkgChannel(GSyst_t gdial) {
+  switch (gdial) {
+  case kXSecTwkDial_RvpCC1pi: {
+    return {true, true, true, 1};
+  }
+  case kXSecTwkDial_RvpCC2pi: {
+    return {true, true, true, 2};
+  }
+  case kXSecTwkDial_RvpNC1pi: {
+    return {true, true, false, 1};
+  }
+  case kXSecTwkDial_RvpNC2pi: {
+    return {true, true, false, 2};
+  }
+  case kXSecTwkDial_RvnCC1pi: {
+    return {true, false, true, 1};
+  }
+  case kXSecTwkDial_RvnCC2pi: {
+    return {true, false, true, 2};
+  }
+  case kXSecTwkDial_RvnNC1pi: {
+    return {true, false, false, 1};
+  }
+  case kXSecTwkDial_RvnNC2pi: {
+    return {true, false, false, 2};
+  }
+  case kXSecTwkDial_RvbarpCC1pi: {
+    return {false, true, true, 1};
+  }
+  case kXSecTwkDial_RvbarpCC2pi: {
+    return {false, true, true, 2};
+  }
+  case kXSecTwkDial_RvbarpNC1pi: {
+    return {false, true, false, 1};
+  }
+  case kXSecTwkDial_RvbarpNC2pi: {
+    return {false, true, false, 2};
+  }
+  case kXSecTwkDial_RvbarnCC1pi: {
+    return {false, false, true, 1};
+  }
+  case kXSecTwkDial_RvbarnCC2pi: {
+    return {false, false, true, 2};
+  }
+  case kXSecTwkDial_RvbarnNC1pi: {
+    return {false, false, false, 1};
+  }
+  case kXSecTwkDial_RvbarnNC2pi: {
+    return {false, false, false, 2};
+  }
+  default: {
+    throw incorrectly_configured()
+        << "[ERROR]: " << GSyst::AsString(gdial)
+        << " is not a non-resonant background dial.";
+  }
+  }
+}
+} // namespace
+
+bool AnalyticNormDialApplies(GSyst_t gdial, EventKinematics const &kin) {
+  switch (gdial) {
+  case kXSecTwkDial_NormCCQE: {
+    return (kin.mode == simb_mode_copy::kQE) && kin.is_cc && !kin.is_charm;
+  }
+  case kXSecTwkDial_NormCCRES: {
+    return (kin.mode == simb_mode_copy::kRes) && kin.is_cc;
+  }
+  case kXSecTwkDial_NormNCRES: {
+    return (kin.mode == simb_mode_copy::kRes) && !kin.is_cc;
+  }
+  default: {}
+  }
+
+  NonResBkgChannel ch = GetNonResBkgChannel(gdial);
+  if ((kin.mode != simb_mode_copy::kDIS) || kin.is_charm ||
+      (kin.W_GeV >= kNonResBkgWmin_GeV)) {
+    return false;
+  }
+  return (IsNeutrinoNRPiChan(kin.NRPiChannel()) == ch.is_nu) &&
+         (IsProtonTargetNRPiChan(kin.NRPiChannel()) == ch.is_proton) &&
+         (IsCCNRPiChan(kin.NRPiChannel()) == ch.is_cc) &&
+         (GetNRPiChanNPi(kin.NRPiChannel()) == ch.NPi);
+}
+
+double GetAnalyticNormWeight(GSyst_t gdial, double twk) {
+  if (std::fabs(twk) < genie::controls::kASmallNum) {
+    return 1;
+  }
+  double fracerr =
+      GSystUncertainty::Instance()->OneSigmaErr(gdial, (twk > 0) ? 1 : -1);
+  return std::max(0., 1 + twk * fracerr);
+}
+
 void AddResponseAndDependentDials(
     SystMetaData const &md, std::string const &ResponseDialName,
     std::vector<GSyst_t> const &DependentDials, std::string const &engine_name,
+    std::string const &calc_mode,
     std::function<GReWeightI *()> EngineInstantiator, bool UseFullHERG,
     std::vector<GENIEResponseParameter> &param_map) {
 
@@ -50,34 +454,32 @@ void AddResponseAndDependentDials(
         continue;
       }
       ResponsePar.dependents.push_back({depdial, GetParamIndex(md, pname)});
+      ResponsePar.applicability.push_back(GetGSystApplicability(depdial));
     }
 
     for (size_t i = 0; i < md[pidx].paramVariations.size(); ++i) {
-      std::unique_ptr<GReWeight> grw = std::make_unique<GReWeight>();
-
-      grw->AdoptWghtCalc(engine_name, EngineInstantiator());
+      GReWeightEngineSpec spec{{{engine_name, calc_mode, EngineInstantiator}},
+                               {}};
 
       for (auto const &dep : ResponsePar.dependents) {
-        grw->Systematics().Init(dep.gdial, md[dep.pidx].paramVariations[i]);
+        spec.dial_values.push_back(
+            {dep.gdial, md[dep.pidx].paramVariations[i]});
       }
 
-      grw->Reconfigure();
-      ResponsePar.Herg.push_back(std::move(grw));
+      ResponsePar.HergSpecs.push_back(std::move(spec));
       if (!UseFullHERG) {
         break;
       }
     }
     if (md[pidx].isCorrection) {
-      std::unique_ptr<GReWeight> grw = std::make_unique<GReWeight>();
-
-      grw->AdoptWghtCalc(engine_name, EngineInstantiator());
+      GReWeightEngineSpec spec{{{engine_name, calc_mode, EngineInstantiator}},
+                               {}};
 
       for (auto const &dep : ResponsePar.dependents) {
-        grw->Systematics().Init(dep.gdial, md[dep.pidx].centralParamValue);
+        spec.dial_values.push_back({dep.gdial, md[dep.pidx].centralParamValue});
       }
 
-      grw->Reconfigure();
-      ResponsePar.Herg.push_back(std::move(grw));
+      ResponsePar.HergSpecs.push_back(std::move(spec));
     }
     param_map.push_back(std::move(ResponsePar));
     // We are ignoring the inter-dependence of the parameters.
@@ -91,26 +493,18 @@ void AddResponseAndDependentDials(
       GENIEResponseParameter DialPar;
       DialPar.pidx = pidx;
       DialPar.dependents.push_back({depdial, pidx});
+      DialPar.applicability.push_back(GetGSystApplicability(depdial));
       for (double var : md[pidx].paramVariations) {
-        std::unique_ptr<GReWeight> grw = std::make_unique<GReWeight>();
-
-        grw->AdoptWghtCalc(engine_name, EngineInstantiator());
-        grw->Systematics().Init(depdial, var);
-
-        grw->Reconfigure();
-        DialPar.Herg.push_back(std::move(grw));
+        DialPar.HergSpecs.push_back(
+            {{{engine_name, calc_mode, EngineInstantiator}}, {{depdial, var}}});
         if (!UseFullHERG) {
           break;
         }
       }
       if (md[pidx].isCorrection) {
-        std::unique_ptr<GReWeight> grw = std::make_unique<GReWeight>();
-
-        grw->AdoptWghtCalc(engine_name, EngineInstantiator());
-        grw->Systematics().Init(depdial, md[pidx].centralParamValue);
-
-        grw->Reconfigure();
-        DialPar.Herg.push_back(std::move(grw));
+        DialPar.HergSpecs.push_back(
+            {{{engine_name, calc_mode, EngineInstantiator}},
+             {{depdial, md[pidx].centralParamValue}}});
       }
       param_map.push_back(std::move(DialPar));
     }
@@ -120,6 +514,7 @@ void AddResponseAndDependentDials(
 void AddIndependentParameters(SystMetaData const &md,
                               std::vector<GSyst_t> const &Dials,
                               std::string const &engine_name,
+                              std::string const &calc_mode,
                               std::function<GReWeightI *()> EngineInstantiator,
                               bool UseFullHERG,
                               std::vector<GENIEResponseParameter> &param_map) {
@@ -132,30 +527,79 @@ void AddIndependentParameters(SystMetaData const &md,
     GENIEResponseParameter dialPar;
     dialPar.pidx = pidx;
     dialPar.dependents.push_back({dial, pidx});
+    dialPar.applicability.push_back(GetGSystApplicability(dial));
 
     for (double var : md[pidx].paramVariations) {
-      std::unique_ptr<GReWeight> grw = std::make_unique<GReWeight>();
-
-      grw->AdoptWghtCalc(engine_name, EngineInstantiator());
-      grw->Systematics().Init(dial, var);
-
-      grw->Reconfigure();
-      dialPar.Herg.push_back(std::move(grw));
+      dialPar.HergSpecs.push_back(
+          {{{engine_name, calc_mode, EngineInstantiator}}, {{dial, var}}});
       if (!UseFullHERG) {
         break;
       }
     }
     if (md[pidx].isCorrection) {
-      std::unique_ptr<GReWeight> grw = std::make_unique<GReWeight>();
+      dialPar.HergSpecs.push_back(
+          {{{engine_name, calc_mode, EngineInstantiator}},
+           {{dial, md[pidx].centralParamValue}}});
+    }
+
+    param_map.push_back(std::move(dialPar));
+  }
+}
 
-      grw->AdoptWghtCalc(engine_name, EngineInstantiator());
-      grw->Systematics().Init(dial, md[pidx].centralParamValue);
+/// Adds normalization dials either as analytic parameters or, if analytic
+/// evaluation is not requested, as independent engine parameters. Engines
+/// are also built for analytic parameters when validating them.
+void AddNormalizationParameters(
+    SystMetaData const &md, std::vector<GSyst_t> const &Dials,
+    std::string const &engine_name, std::string const &calc_mode,
+    std::function<GReWeightI *()> EngineInstantiator,
+    fhicl::ParameterSet const &tool_options,
+    std::vector<GENIEResponseParameter> &param_map) {
 
-      grw->Reconfigure();
-      dialPar.Herg.push_back(std::move(grw));
+  bool UseFullHERG = tool_options.get<bool>("UseFullHERG", false);
+  bool AnalyticNormDials = tool_options.get<bool>("AnalyticNormDials", false);
+  bool ValidateAnalyticNormDials =
+      tool_options.get<bool>("ValidateAnalyticNormDials", false);
+
+  if (!AnalyticNormDials || ValidateAnalyticNormDials) {
+    size_t first_added = param_map.size();
+    AddIndependentParameters(md, Dials, engine_name, calc_mode,
+                             EngineInstantiator, UseFullHERG, param_map);
+    if (!AnalyticNormDials) {
+      return;
+    }
+    for (size_t p_it = first_added; p_it < param_map.size(); ++p_it) {
+      param_map[p_it].IsAnalyticNorm = true;
+    }
+  } else {
+    for (GSyst_t const &dial : Dials) {
+      if (!HasParam(md, GSyst::AsString(dial))) {
+        continue;
+      }
+      size_t pidx = GetParamIndex(md, GSyst::AsString(dial));
+      GENIEResponseParameter dialPar;
+      dialPar.pidx = pidx;
+      dialPar.dependents.push_back({dial, pidx});
+      dialPar.applicability.push_back(GetGSystApplicability(dial));
+      dialPar.IsAnalyticNorm = true;
+      param_map.push_back(std::move(dialPar));
     }
+  }
 
-    param_map.push_back(std::move(dialPar));
+  for (GENIEResponseParameter &par : param_map) {
+    if (!par.IsAnalyticNorm || par.AnalyticNormWeights.size()) {
+      continue;
+    }
+    SystParamHeader const &hdr = md[par.pidx];
+    GSyst_t dial = par.dependents.front().gdial;
+    if (hdr.isCorrection) {
+      par.AnalyticNormWeights.push_back(
+          GetAnalyticNormWeight(dial, hdr.centralParamValue));
+    } else {
+      for (double var : hdr.paramVariations) {
+        par.AnalyticNormWeights.push_back(GetAnalyticNormWeight(dial, var));
+      }
+    }
   }
 }
 
@@ -168,21 +612,24 @@ ConfigureQEWeightEngine(SystMetaData const &QEmd,
   bool UseFullHERG = tool_options.get<bool>("UseFullHERG", false);
 
   // Add NormCCQE
-  AddIndependentParameters(
+  AddNormalizationParameters(
       QEmd, {kXSecTwkDial_NormCCQE}, "xsec_ccqe_axFF",
+      "GReWeightNuXSecCCQE::kModeNormAndMaShape",
       []() {
         GReWeightNuXSecCCQE *rwccqe = new GReWeightNuXSecCCQE();
 
         rwccqe->SetMode(GReWeightNuXSecCCQE::kModeNormAndMaShape);
         return rwccqe;
       },
-      UseFullHERG, param_map);
+      tool_options, param_map);
 
   // Add MACCQE
   bool MAQEIsShapeOnly = tool_options.get<bool>("MAQEIsShapeOnly", false);
   AddIndependentParameters(
       QEmd, {MAQEIsShapeOnly ? kXSecTwkDial_MaCCQEshape : kXSecTwkDial_MaCCQE},
       "xsec_ccqe_axFF",
+      MAQEIsShapeOnly ? "GReWeightNuXSecCCQE::kModeNormAndMaShape"
+                      : "GReWeightNuXSecCCQE::kModeMa",
       [=]() {
         GReWeightNuXSecCCQE *rwccqe = new GReWeightNuXSecCCQE();
 
@@ -195,11 +642,13 @@ ConfigureQEWeightEngine(SystMetaData const &QEmd,
 
   // Add AxFFCCQEShape
   AddIndependentParameters(QEmd, {kXSecTwkDial_AxFFCCQEshape}, "xsec_ccqe_axFF",
+                           "GReWeightNuXSecCCQEaxial",
                            []() { return new GReWeightNuXSecCCQEaxial(); },
                            UseFullHERG, param_map);
 
   // Add ZNormCCQE
   AddIndependentParameters(QEmd, {kXSecTwkDial_ZNormCCQE}, "xsec_ccqe_axFF",
+                           "GReWeightNuXSecCCQE::kModeZExp",
                            []() {
                              GReWeightNuXSecCCQE *rwccqe =
                                  new GReWeightNuXSecCCQE();
@@ -214,7 +663,7 @@ ConfigureQEWeightEngine(SystMetaData const &QEmd,
       QEmd, "ZExpAVariationResponse",
       {kXSecTwkDial_ZExpA1CCQE, kXSecTwkDial_ZExpA2CCQE,
        kXSecTwkDial_ZExpA3CCQE, kXSecTwkDial_ZExpA4CCQE},
-      "xsec_ccqe_axFF",
+      "xsec_ccqe_axFF", "GReWeightNuXSecCCQE::kModeZExp",
       []() {
         GReWeightNuXSecCCQE *rwccqe = new GReWeightNuXSecCCQE();
 
@@ -240,9 +689,11 @@ ConfigureQEWeightEngine(SystMetaData const &QEmd,
         }
         attached_AxFFQEShape = true;
 
-        for (auto &grw : grp.Herg) {
-          grw->AdoptWghtCalc("xsec_ccqe_axFF", new GReWeightNuXSecCCQEaxial());
-          grw->Systematics().Init(kXSecTwkDial_AxFFCCQEshape, 1);
+        for (GReWeightEngineSpec &spec : grp.HergSpecs) {
+          spec.calcs.push_back(
+              {"xsec_ccqe_axFF", "GReWeightNuXSecCCQEaxial",
+               []() { return new GReWeightNuXSecCCQEaxial(); }});
+          spec.dial_values.push_back({kXSecTwkDial_AxFFCCQEshape, 1});
         }
       }
       // Only want to add in dipole->z-exp reweighting once
@@ -260,15 +711,18 @@ ConfigureQEWeightEngine(SystMetaData const &QEmd,
 
   AddIndependentParameters(
       QEmd, {kXSecTwkDial_VecFFCCQEshape}, "xsec_ccqe_vecFF",
-      []() { return new GReWeightNuXSecCCQEvec; }, UseFullHERG, param_map);
+      "GReWeightNuXSecCCQEvec", []() { return new GReWeightNuXSecCCQEvec; },
+      UseFullHERG, param_map);
 
   AddIndependentParameters(
       QEmd, {kXSecTwkDial_RPA_CCQE}, "xsec_ccqe_rpa",
-      []() { return new GReWeightNuXSecCCQE; }, UseFullHERG, param_map);
+      "GReWeightNuXSecCCQE", []() { return new GReWeightNuXSecCCQE; },
+      UseFullHERG, param_map);
 
   AddIndependentParameters(
       QEmd, {kXSecTwkDial_CoulombCCQE}, "xsec_ccqe_coulomb",
-      []() { return new GReWeightNuXSecCCQE; }, UseFullHERG, param_map);
+      "GReWeightNuXSecCCQE", []() { return new GReWeightNuXSecCCQE; },
+      UseFullHERG, param_map);
 
   return param_map;
 }
@@ -291,7 +745,8 @@ ConfigureMECWeightEngine(SystMetaData const &MECmd,
         kXSecTwkDial_FracDelta_CCMEC,
         kXSecTwkDial_XSecShape_CCMEC
       },
-      "xsec_mec", []() { return new GReWeightXSecMEC; }, UseFullHERG, param_map);
+      "xsec_mec", "GReWeightXSecMEC", []() { return new GReWeightXSecMEC; },
+      UseFullHERG, param_map);
 
   return param_map;
 
@@ -308,7 +763,8 @@ ConfigureNCELWeightEngine(SystMetaData const &NCELmd,
   AddResponseAndDependentDials(
       NCELmd, "NCELVariationResponse",
       {kXSecTwkDial_MaNCEL, kXSecTwkDial_EtaNCEL}, "xsec_NCEl_FF",
-      []() { return new GReWeightNuXSecNCEL; }, UseFullHERG, param_map);
+      "GReWeightNuXSecNCEL", []() { return new GReWeightNuXSecNCEL; },
+      UseFullHERG, param_map);
 
   return param_map;
 }
@@ -322,15 +778,16 @@ ConfigureRESWeightEngine(SystMetaData const &RESmd,
   bool UseFullHERG = tool_options.get<bool>("UseFullHERG", false);
 
   // Add any CCRES parameters
-  AddIndependentParameters(
+  AddNormalizationParameters(
       RESmd, {kXSecTwkDial_NormCCRES}, "xsec_ccres_FF",
+      "GReWeightNuXSecCCRES::kModeNormAndMaMvShape",
       []() {
         GReWeightNuXSecCCRES *rwccres = new GReWeightNuXSecCCRES();
 
         rwccres->SetMode(GReWeightNuXSecCCRES::kModeNormAndMaMvShape);
         return rwccres;
       },
-      UseFullHERG, param_map);
+      tool_options, param_map);
 
   bool CCRESIsShapeOnly = tool_options.get<bool>("CCRESIsShapeOnly", false);
   AddResponseAndDependentDials(
@@ -338,6 +795,8 @@ ConfigureRESWeightEngine(SystMetaData const &RESmd,
       {CCRESIsShapeOnly ? kXSecTwkDial_MaCCRESshape : kXSecTwkDial_MaCCRES,
        CCRESIsShapeOnly ? kXSecTwkDial_MvCCRESshape : kXSecTwkDial_MvCCRES},
       "xsec_ccres_FF",
+      CCRESIsShapeOnly ? "GReWeightNuXSecCCRES::kModeNormAndMaMvShape"
+                       : "GReWeightNuXSecCCRES::kModeMaMv",
       [=]() {
         GReWeightNuXSecCCRES *rwccres = new GReWeightNuXSecCCRES();
         rwccres->SetMode(CCRESIsShapeOnly
@@ -347,15 +806,16 @@ ConfigureRESWeightEngine(SystMetaData const &RESmd,
       },
       UseFullHERG, param_map);
 
-  AddIndependentParameters(
+  AddNormalizationParameters(
       RESmd, {kXSecTwkDial_NormNCRES}, "xsec_ncres_FF",
+      "GReWeightNuXSecNCRES::kModeNormAndMaMvShape",
       []() {
         GReWeightNuXSecNCRES *rwncres = new GReWeightNuXSecNCRES();
 
         rwncres->SetMode(GReWeightNuXSecNCRES::kModeNormAndMaMvShape);
         return rwncres;
       },
-      UseFullHERG, param_map);
+      tool_options, param_map);
 
   bool NCRESIsShapeOnly = tool_options.get<bool>("NCRESIsShapeOnly", false);
   AddResponseAndDependentDials(
@@ -363,6 +823,8 @@ ConfigureRESWeightEngine(SystMetaData const &RESmd,
       {NCRESIsShapeOnly ? kXSecTwkDial_MaNCRESshape : kXSecTwkDial_MaNCRES,
        NCRESIsShapeOnly ? kXSecTwkDial_MvNCRESshape : kXSecTwkDial_MvNCRES},
       "xsec_ncres_FF",
+      NCRESIsShapeOnly ? "GReWeightNuXSecNCRES::kModeNormAndMaMvShape"
+                       : "GReWeightNuXSecNCRES::kModeMaMv",
       [=]() {
         GReWeightNuXSecNCRES *rwncres = new GReWeightNuXSecNCRES();
         rwncres->SetMode(NCRESIsShapeOnly
@@ -372,7 +834,7 @@ ConfigureRESWeightEngine(SystMetaData const &RESmd,
       },
       UseFullHERG, param_map);
 
-  AddIndependentParameters(
+  AddNormalizationParameters(
       RESmd,
       {kXSecTwkDial_RvpCC1pi, kXSecTwkDial_RvpCC2pi, kXSecTwkDial_RvpNC1pi,
        kXSecTwkDial_RvpNC2pi, kXSecTwkDial_RvnCC1pi, kXSecTwkDial_RvnCC2pi,
@@ -381,19 +843,20 @@ ConfigureRESWeightEngine(SystMetaData const &RESmd,
        kXSecTwkDial_RvbarpNC2pi, kXSecTwkDial_RvbarnCC1pi,
        kXSecTwkDial_RvbarnCC2pi, kXSecTwkDial_RvbarnNC1pi,
        kXSecTwkDial_RvbarnNC2pi},
-      "xsec_NonResBkg", []() { return new GReWeightNonResonanceBkg(); },
-      UseFullHERG, param_map);
+      "xsec_NonResBkg", "GReWeightNonResonanceBkg",
+      []() { return new GReWeightNonResonanceBkg(); },
+      tool_options, param_map);
 
   AddIndependentParameters(RESmd,
                            {kRDcyTwkDial_BR1gamma, kRDcyTwkDial_BR1eta,
                             kRDcyTwkDial_Theta_Delta2Npi},
-                           "xsec_ResDecay",
+                           "xsec_ResDecay", "GReWeightResonanceDecay",
                            []() { return new GReWeightResonanceDecay(); },
                            UseFullHERG, param_map);
 
   AddIndependentParameters(RESmd,
                            {kRDcyTwkDial_Theta_Delta2NRad},
-                           "xsec_DeltaRad",
+                           "xsec_DeltaRad", "GReWeightDeltaradAngle",
                            []() { return new GReWeightDeltaradAngle(); },
                            UseFullHERG, param_map);
 
@@ -412,7 +875,8 @@ ConfigureCOHWeightEngine(SystMetaData const &COHmd,
   AddResponseAndDependentDials(
       COHmd, "COHVariationResponse",
       {kXSecTwkDial_MaCOHpi, kXSecTwkDial_R0COHpi, kXSecTwkDial_NormCCCOHpi, kXSecTwkDial_NormNCCOHpi}, "xsec_COH",
-      []() { return new GReWeightNuXSecCOH; }, UseFullHERG, param_map);
+      "GReWeightNuXSecCOH", []() { return new GReWeightNuXSecCOH; },
+      UseFullHERG, param_map);
 
   return param_map;
 }
@@ -432,6 +896,8 @@ ConfigureDISWeightEngine(SystMetaData const &DISmd,
        DISBYIsShapeOnly ? kXSecTwkDial_CV1uBYshape : kXSecTwkDial_CV1uBY,
        DISBYIsShapeOnly ? kXSecTwkDial_CV2uBYshape : kXSecTwkDial_CV2uBY},
       "xsec_dis_FF",
+      DISBYIsShapeOnly ? "GReWeightNuXSecDIS::kModeABCV12uShape"
+                       : "GReWeightNuXSecDIS::kModeABCV12u",
       [=]() {
         GReWeightNuXSecDIS *rwdis = new GReWeightNuXSecDIS();
         rwdis->SetMode(DISBYIsShapeOnly ? GReWeightNuXSecDIS::kModeABCV12uShape
@@ -443,9 +909,11 @@ ConfigureDISWeightEngine(SystMetaData const &DISmd,
   AddResponseAndDependentDials(
       DISmd, "AGKYVariationResponse",
       {kHadrAGKYTwkDial_xF1pi, kHadrAGKYTwkDial_pT1pi}, "hadronization",
-      []() { return new GReWeightAGKY; }, UseFullHERG, param_map);
+      "GReWeightAGKY", []() { return new GReWeightAGKY; }, UseFullHERG,
+      param_map);
 
   AddIndependentParameters(DISmd, {kHadrNuclTwkDial_FormZone}, "form_zone",
+                           "GReWeightFZone",
                            []() { return new GReWeightFZone; }, UseFullHERG,
                            param_map);
 
@@ -467,7 +935,8 @@ ConfigureFSIWeightEngine(systtools::SystMetaData const &FSImd,
        // -- S. Gardiner, 19 December 2018
        kINukeTwkDial_FrInel_pi, kINukeTwkDial_FrAbs_pi,
        kINukeTwkDial_FrPiProd_pi},
-      "INuke_pi", []() { return new GReWeightINuke; }, UseFullHERG, param_map);
+      "INuke_pi", "GReWeightINuke", []() { return new GReWeightINuke; },
+      UseFullHERG, param_map);
 
   AddResponseAndDependentDials(
       FSImd, "FSI_N_VariationResponse",
@@ -476,7 +945,8 @@ ConfigureFSIWeightEngine(systtools::SystMetaData const &FSImd,
        // Nucleon elastic fate was removed in hA2018 for GENIE v3
        // -- S. Gardiner, 19 December 2018
        kINukeTwkDial_FrInel_N, kINukeTwkDial_FrAbs_N, kINukeTwkDial_FrPiProd_N},
-      "INuke_N", []() { return new GReWeightINuke; }, UseFullHERG, param_map);
+      "INuke_N", "GReWeightINuke", []() { return new GReWeightINuke; },
+      UseFullHERG, param_map);
 
   return param_map;
 }
@@ -491,7 +961,8 @@ ConfigureOtherWeightEngine(systtools::SystMetaData const &Othermd,
 
   AddIndependentParameters(
       Othermd, {kSystNucl_CCQEPauliSupViaKF, kSystNucl_CCQEMomDistroFGtoSF},
-      "FGM", []() { return new GReWeightFGM; }, UseFullHERG, param_map);
+      "FGM", "GReWeightFGM", []() { return new GReWeightFGM; }, UseFullHERG,
+      param_map);
 
   return param_map;
 }
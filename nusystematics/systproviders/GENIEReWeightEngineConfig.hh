@@ -15,6 +15,60 @@
 
 namespace nusyst {
 
+/// Instantiates and reconfigures the engine described by spec. Builds are
+/// serialized between threads, as both steps go through GENIE's algorithm
+/// singletons.
+///
+/// If build_seconds is given, it is set to the build time, excluding any time
+/// spent waiting for another thread's build.
+std::unique_ptr<genie::rew::GReWeight>
+BuildWeightEngine(GReWeightEngineSpec const &spec,
+                  double *build_seconds = nullptr);
+
+/// An engine for BuildSharedWeightEngines to build, engines that are never
+/// reconfigured after they are built are shareable.
+struct GReWeightEngineRequest {
+  GReWeightEngineSpec const *spec;
+  bool shareable;
+};
+
+/// Builds an engine for each request. Shareable requests are taken from, or
+/// added to, pool and share one engine per GetPoolKey.
+///
+/// If build_seconds is given, it is filled with the build time of each
+/// request, 0 for those that re-use an engine.
+std::vector<std::shared_ptr<SharedGReWeight>>
+BuildSharedWeightEngines(std::vector<GReWeightEngineRequest> const &requests,
+                         GReWeightEnginePool &pool,
+                         std::vector<double> *build_seconds = nullptr);
+
+/// Builds the engines described by the HergSpecs of each parameter.
+///
+/// Parameters with an engine per variation never reconfigure them, so share
+/// engines with identical specs through pool. Parameters that already hold
+/// one engine per spec are left untouched.
+///
+/// Returns the summed build time, in seconds, of the engines built for each
+/// parameter.
+std::vector<double>
+BuildWeightEngines(systtools::SystMetaData const &md,
+                   std::vector<GENIEResponseParameter> &param_map,
+                   GReWeightEnginePool &pool);
+
+/// Dials that are not explicitly handled apply to every event.
+GSystApplicability GetGSystApplicability(genie::rew::GSyst_t);
+
+/// Whether the dial only scales the cross section of the events it applies
+/// to, and so can be evaluated with GetAnalyticNormWeight rather than a GENIE
+/// weight engine.
+bool IsAnalyticNormDial(genie::rew::GSyst_t);
+/// Reproduces the event selection of the GENIE calculator for an analytic
+/// normalization dial.
+bool AnalyticNormDialApplies(genie::rew::GSyst_t, EventKinematics const &);
+/// 1 + twk * one-sigma fractional error, as registered with
+/// GSystUncertainty, clamped at 0.
+double GetAnalyticNormWeight(genie::rew::GSyst_t, double twk);
+
 std::vector<GENIEResponseParameter>
 ConfigureQEWeightEngine(systtools::SystMetaData const &,
                         fhicl::ParameterSet const &tool_options);
@@ -3,6 +3,8 @@
 #include "nusystematics/systproviders/GENIEReWeightEngineConfig.hh"
 #include "nusystematics/systproviders/GENIEReWeightParamConfig.hh"
 
+#include "nusystematics/utility/ThreadOutputMute.hh"
+
 #include "systematicstools/utility/printers.hh"
 #include "systematicstools/utility/string_parsers.hh"
 
@@ -15,18 +17,102 @@
 #include "Framework/Messenger/Messenger.h"
 
 #include "TH1.h"
+#include "TROOT.h"
+
+#include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <utility>
 
 using namespace fhicl;
 using namespace systtools;
 using namespace nusyst;
 
+namespace {
+/// Returns 0 where /proc/self/statm is unavailable.
+double GetResidentMemoryMB() {
+  std::ifstream statm("/proc/self/statm");
+  size_t NPagesTotal = 0, NPagesResident = 0;
+  if (!(statm >> NPagesTotal >> NPagesResident)) {
+    return 0;
+  }
+  return double(NPagesResident) * double(sysconf(_SC_PAGESIZE)) / 1E6;
+}
+
+/// Once per process: sets the whisper Messenger priorities, wraps std::cout
+/// so that the full-HERG calculations can be muted per thread with
+/// ScopedThreadOutputMute, and switches TH1::AddDirectory on for the
+/// histograms that GENIE weight calculators may book while calculating.
+/// Later changes to either setting by the caller are respected.
+void ConfigureGENIEOutput() {
+  static std::once_flag configured;
+  std::call_once(configured, []() {
+    genie::Messenger::Instance()->SetPrioritiesFromXmlFile(
+        "Messenger_whisper.xml");
+    ThreadMutableStreambuf::Install(std::cout);
+    TH1::AddDirectory(true);
+  });
+}
+
+/// Calls fn, adding its run time to *seconds and to stats unless they are
+/// null.
+template <typename F>
+void AddElapsedSeconds(double *seconds, LatencyStats *stats, F &&fn) {
+  if (!seconds && !stats) {
+    fn();
+    return;
+  }
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  fn();
+  double elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  if (seconds) {
+    *seconds += elapsed;
+  }
+  if (stats) {
+    stats->Add(elapsed);
+  }
+}
+template <typename F> void AddElapsedSeconds(double *seconds, F &&fn) {
+  AddElapsedSeconds(seconds, nullptr, std::forward<F>(fn));
+}
+} // namespace
+
 GENIEReWeight::GENIEReWeight(ParameterSet const &params)
     : IGENIESystProvider_tool(params), fHaveReconfiguredOneOfTheHERG(false),
+      fThrowIsSet(false), fUseApplicabilityFilter(true), fValidateAnalyticNormDials(false),
+      fProfileDials(false),
+      fProfilingHybridHERG(false), fHybridHERGProfileEvents(0),
+      fNHybridProfiledEvents(0), fEngineMemoryMB(0), NThrowBankUniverses(0),
+      fEventSerial(0),
       valid_file(nullptr), valid_tree(nullptr) {}
 
+GENIEReWeight::GENIEReWeight(GENIEReWeight const &other)
+    : IGENIESystProvider_tool(other), fHaveReconfiguredOneOfTheHERG(false),
+      fThrowIsSet(false),
+      fUseApplicabilityFilter(other.fUseApplicabilityFilter),
+      fValidateAnalyticNormDials(other.fValidateAnalyticNormDials),
+      fProfileDials(other.fProfileDials),
+      fProfilingHybridHERG(false), fHybridHERGProfileEvents(0),
+      fNHybridProfiledEvents(0), fEngineMemoryMB(0), NThrowBankUniverses(0),
+      fEventSerial(0),
+      tool_options(other.tool_options), fill_valid_tree(false),
+      valid_file(nullptr), valid_tree(nullptr) {
+  ConfigureWeightEngines(tool_options);
+}
+
+std::unique_ptr<IGENIESystProvider_tool> GENIEReWeight::Clone() const {
+  return std::unique_ptr<GENIEReWeight>(new GENIEReWeight(*this));
+}
+
 std::string GENIEReWeight::AsString() {
   CheckHaveMetaData();
   return "";
@@ -44,6 +130,36 @@ SystMetaData GENIEReWeight::BuildSystMetaData(ParameterSet const &params,
   bool UseFullHERG = params.get<bool>("UseFullHERG", false);
   tool_options.put("UseFullHERG", UseFullHERG);
 
+  size_t FullHERGThreads = params.get<size_t>("FullHERGThreads", 1);
+  tool_options.put("FullHERGThreads", FullHERGThreads);
+
+  bool HybridHERG = params.get<bool>("HybridHERG", false);
+  tool_options.put("HybridHERG", HybridHERG);
+  tool_options.put("HybridHERGProfileEvents",
+                   params.get<size_t>("HybridHERGProfileEvents", 100));
+  tool_options.put("HybridHERGMaxEngines",
+                   params.get<size_t>("HybridHERGMaxEngines",
+                                      std::numeric_limits<size_t>::max()));
+  tool_options.put("HybridHERGMaxMemoryMB",
+                   params.get<double>("HybridHERGMaxMemoryMB", 0));
+  tool_options.put("FullHERGParameters",
+                   params.get<std::vector<std::string>>("FullHERGParameters",
+                                                        {}));
+  tool_options.put("ThrowBankMaxEngines",
+                   params.get<size_t>("ThrowBankMaxEngines",
+                                      std::numeric_limits<size_t>::max()));
+  tool_options.put("ProfileDials", params.get<bool>("ProfileDials", false));
+
+  bool UseApplicabilityFilter =
+      params.get<bool>("UseApplicabilityFilter", true);
+  tool_options.put("UseApplicabilityFilter", UseApplicabilityFilter);
+
+  bool AnalyticNormDials = params.get<bool>("AnalyticNormDials", false);
+  tool_options.put("AnalyticNormDials", AnalyticNormDials);
+  bool ValidateAnalyticNormDials =
+      params.get<bool>("ValidateAnalyticNormDials", false);
+  tool_options.put("ValidateAnalyticNormDials", ValidateAnalyticNormDials);
+
   std::string genie_tune_name = params.get<std::string>("genie_tune_name",
                                                    "${GENIE_XSEC_TUNE}");
   tool_options.put("genie_tune_name",genie_tune_name);
@@ -127,40 +243,277 @@ bool GENIEReWeight::SetupResponseCalculator(
   // Tell GENIE about the event generator list and tune
   evgb::SetEventGeneratorListAndTune( evgen_list_name, genie_tune_name );
 
+  // Keep hold of the options used to build the engines so that clones can
+  // build their own.
+  this->tool_options = tool_options;
+
+  ConfigureWeightEngines(tool_options);
+
+  fUseApplicabilityFilter =
+      tool_options.get<bool>("UseApplicabilityFilter", true);
+  fValidateAnalyticNormDials =
+      tool_options.get<bool>("AnalyticNormDials", false) &&
+      tool_options.get<bool>("ValidateAnalyticNormDials", false);
+  fProfileDials = tool_options.get<bool>("ProfileDials", false);
+
+  fill_valid_tree = tool_options.get("fill_valid_tree", false);
+  if (fill_valid_tree) {
+    InitValidTree();
+  }
+
+  ConfigureGENIEOutput();
+  return true;
+}
+
+void GENIEReWeight::ConfigureWeightEngines(
+    fhicl::ParameterSet const &tool_options) {
+
+  bool UseFullHERG = tool_options.get<bool>("UseFullHERG", false);
+  bool HybridHERG = !UseFullHERG && tool_options.get<bool>("HybridHERG", false);
+  std::vector<std::string> FullHERGParameters =
+      tool_options.get<std::vector<std::string>>("FullHERGParameters", {});
+  bool PinnedHERG = !UseFullHERG && FullHERGParameters.size();
+
+  // Hybrid and pinned layouts are configured as full HERG and then reduced,
+  // so that the specs of every full engine set are to hand.
+  fhicl::ParameterSet engine_options = tool_options;
+  if (HybridHERG || PinnedHERG) {
+    engine_options.put_or_replace("UseFullHERG", true);
+  }
+
+  // Name of each dial group and the end of its parameters in
+  // ResponseToGENIEParameters.
+  std::vector<std::pair<std::string, size_t>> group_ends;
+
   extend_ResponseToGENIEParameters(
-      ConfigureQEWeightEngine(GetSystMetaData(), tool_options));
+      ConfigureQEWeightEngine(GetSystMetaData(), engine_options));
+  group_ends.emplace_back("QE", ResponseToGENIEParameters.size());
 
   extend_ResponseToGENIEParameters(
-      ConfigureMECWeightEngine(GetSystMetaData(), tool_options));
+      ConfigureMECWeightEngine(GetSystMetaData(), engine_options));
+  group_ends.emplace_back("MEC", ResponseToGENIEParameters.size());
 
   extend_ResponseToGENIEParameters(
-      ConfigureNCELWeightEngine(GetSystMetaData(), tool_options));
+      ConfigureNCELWeightEngine(GetSystMetaData(), engine_options));
+  group_ends.emplace_back("NCEL", ResponseToGENIEParameters.size());
 
   extend_ResponseToGENIEParameters(
-      ConfigureRESWeightEngine(GetSystMetaData(), tool_options));
+      ConfigureRESWeightEngine(GetSystMetaData(), engine_options));
+  group_ends.emplace_back("RES", ResponseToGENIEParameters.size());
 
   extend_ResponseToGENIEParameters(
-      ConfigureCOHWeightEngine(GetSystMetaData(), tool_options));
+      ConfigureCOHWeightEngine(GetSystMetaData(), engine_options));
+  group_ends.emplace_back("COH", ResponseToGENIEParameters.size());
 
   extend_ResponseToGENIEParameters(
-      ConfigureDISWeightEngine(GetSystMetaData(), tool_options));
+      ConfigureDISWeightEngine(GetSystMetaData(), engine_options));
+  group_ends.emplace_back("DIS", ResponseToGENIEParameters.size());
 
   extend_ResponseToGENIEParameters(
-      ConfigureFSIWeightEngine(GetSystMetaData(), tool_options));
+      ConfigureFSIWeightEngine(GetSystMetaData(), engine_options));
+  group_ends.emplace_back("FSI", ResponseToGENIEParameters.size());
 
   extend_ResponseToGENIEParameters(
-      ConfigureOtherWeightEngine(GetSystMetaData(), tool_options));
+      ConfigureOtherWeightEngine(GetSystMetaData(), engine_options));
+  group_ends.emplace_back("Other", ResponseToGENIEParameters.size());
+
+  DialProfiles.assign(ResponseToGENIEParameters.size(), DialProfile());
+
+  if (HybridHERG || PinnedHERG) {
+    ReduceHERGLayout(FullHERGParameters);
+  }
+
+  double setup_start_memory_MB = GetResidentMemoryMB();
+  std::chrono::steady_clock::time_point setup_start =
+      std::chrono::steady_clock::now();
+  std::vector<double> build_seconds =
+      BuildWeightEngines(GetSystMetaData(), ResponseToGENIEParameters,
+                         EnginePool);
+  double setup_seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - setup_start)
+                             .count();
+  double setup_memory_MB = GetResidentMemoryMB() - setup_start_memory_MB;
+
+  // Engines shared with an earlier group are counted there.
+  std::set<SharedGReWeight const *> built_engines;
+  size_t group_begin = 0;
+  size_t NEnginesTotal = 0;
+  for (auto const &group : group_ends) {
+    size_t NEngines = 0;
+    double group_seconds = 0;
+    for (size_t r_it = group_begin; r_it < group.second; ++r_it) {
+      for (auto const &grw : ResponseToGENIEParameters[r_it].Herg) {
+        NEngines += built_engines.insert(grw.get()).second;
+      }
+      group_seconds += build_seconds[r_it];
+    }
+    if (NEngines) {
+      std::cout << "[INFO]: Set up " << NEngines << " " << group.first
+                << " GReWeight engines in " << group_seconds << " s."
+                << std::endl;
+    }
+    NEnginesTotal += NEngines;
+    group_begin = group.second;
+  }
+  std::cout << "[INFO]: Set up " << NEnginesTotal << " GReWeight engines in "
+            << setup_seconds << " s." << std::endl;
+
+  if (NEnginesTotal && (setup_start_memory_MB > 0) && (setup_memory_MB > 0)) {
+    fEngineMemoryMB = setup_memory_MB / double(NEnginesTotal);
+  }
+
+  if (HybridHERG) {
+    fHybridHERGProfileEvents =
+        tool_options.get<size_t>("HybridHERGProfileEvents", 100);
+    HybridProfiles.assign(ResponseToGENIEParameters.size(), HERGProfile());
+    fNHybridProfiledEvents = 0;
+    fProfilingHybridHERG = true;
+    std::cout << "[INFO]: Profiling reconfigured GReWeight engines over the "
+                 "first "
+              << fHybridHERGProfileEvents
+              << " events to choose the hybrid HERG layout." << std::endl;
+    if (!fHybridHERGProfileEvents) {
+      ChooseHybridHERGLayout();
+    }
+  } else {
+    HybridFullHergSpecs.clear();
+  }
+
+  size_t FullHERGThreads = tool_options.get<size_t>("FullHERGThreads", 1);
+  if ((UseFullHERG || HybridHERG || PinnedHERG) && (FullHERGThreads > 1)) {
+    ROOT::EnableThreadSafety();
+    FullHERGPool = std::make_unique<ThreadPool>(FullHERGThreads);
+    std::cout << "[WARN]: Evaluating full-HERG variations on "
+              << FullHERGThreads
+              << " threads. GENIE weight calculators share algorithm "
+                 "instances that are not thread-safe, so responses may be "
+                 "wrong. Set FullHERGThreads: 1 for validated results."
+              << std::endl;
+  }
 
   std::cout << "[INFO]: Done!" << std::endl;
+}
 
-  fill_valid_tree = tool_options.get("fill_valid_tree", false);
-  if (fill_valid_tree) {
-    InitValidTree();
+void GENIEReWeight::ReduceHERGLayout(
+    std::vector<std::string> const &FullHERGParameters) {
+
+  std::set<std::string> KeepFull(FullHERGParameters.begin(),
+                                 FullHERGParameters.end());
+
+  HybridFullHergSpecs.assign(ResponseToGENIEParameters.size(), {});
+  for (size_t r_it = 0; r_it < ResponseToGENIEParameters.size(); ++r_it) {
+    GENIEResponseParameter &GENIEResponse = ResponseToGENIEParameters[r_it];
+    SystParamHeader const &hdr = GetSystMetaData()[GENIEResponse.pidx];
+
+    if (KeepFull.erase(hdr.prettyName)) {
+      continue;
+    }
+    // Corrections have a single variation and analytic normalization engines
+    // are only used for validation.
+    if (hdr.isCorrection || GENIEResponse.IsAnalyticNorm ||
+        (GENIEResponse.HergSpecs.size() < 2)) {
+      continue;
+    }
+    HybridFullHergSpecs[r_it] = GENIEResponse.HergSpecs;
+    GENIEResponse.HergSpecs.resize(1);
   }
 
-  genie::Messenger::Instance()->SetPrioritiesFromXmlFile(
-      "Messenger_whisper.xml");
-  return true;
+  if (KeepFull.size()) {
+    throw invalid_HERG_layout()
+        << "[ERROR]: FullHERGParameters names " << std::quoted(*KeepFull.begin())
+        << ", which is not a GENIEReWeight response parameter.";
+  }
+}
+
+void GENIEReWeight::ChooseHybridHERGLayout() {
+  fProfilingHybridHERG = false;
+
+  struct Candidate {
+    size_t resp_idx;
+    size_t NExtraEngines;
+    double SavedSecondsPerEvent;
+  };
+  std::vector<Candidate> candidates;
+
+  double NEvents = std::max(size_t(1), fNHybridProfiledEvents);
+  std::cout << "[INFO]: Reconfigured GReWeight engine costs over "
+            << fNHybridProfiledEvents << " events:" << std::endl;
+  for (size_t r_it = 0; r_it < ResponseToGENIEParameters.size(); ++r_it) {
+    if (!HybridFullHergSpecs[r_it].size()) {
+      continue;
+    }
+    GENIEResponseParameter const &GENIEResponse =
+        ResponseToGENIEParameters[r_it];
+    HERGProfile const &profile = HybridProfiles[r_it];
+    size_t NExtraEngines =
+        HybridFullHergSpecs[r_it].size() - GENIEResponse.HergSpecs.size();
+
+    std::cout << "[INFO]:\t"
+              << GetSystMetaData()[GENIEResponse.pidx].prettyName
+              << ": Reconfigure " << (1E3 * profile.ReconfigureSeconds / NEvents)
+              << " ms/event, CalcWeight "
+              << (1E3 * profile.CalcWeightSeconds / NEvents)
+              << " ms/event, full HERG needs " << NExtraEngines
+              << " more engines." << std::endl;
+
+    // A full engine set removes the reconfigures, the CalcWeight cost is the
+    // same either way.
+    if (profile.ReconfigureSeconds > 0) {
+      candidates.push_back(
+          {r_it, NExtraEngines, profile.ReconfigureSeconds / NEvents});
+    }
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](Candidate const &l, Candidate const &r) {
+                     return (l.SavedSecondsPerEvent / l.NExtraEngines) >
+                            (r.SavedSecondsPerEvent / r.NExtraEngines);
+                   });
+
+  size_t MaxEngines = tool_options.get<size_t>(
+      "HybridHERGMaxEngines", std::numeric_limits<size_t>::max());
+  double MaxMemoryMB = tool_options.get<double>("HybridHERGMaxMemoryMB", 0);
+  if (MaxMemoryMB > 0) {
+    if (fEngineMemoryMB > 0) {
+      MaxEngines = std::min(MaxEngines, size_t(MaxMemoryMB / fEngineMemoryMB));
+    } else {
+      std::cout << "[INFO]: Could not estimate the memory used by a GReWeight "
+                   "engine, HybridHERGMaxMemoryMB is ignored."
+                << std::endl;
+    }
+  }
+
+  size_t NEngines = 0;
+  std::vector<std::string> FullHERGParameters;
+  for (Candidate const &c : candidates) {
+    if ((MaxEngines - NEngines) < c.NExtraEngines) {
+      continue;
+    }
+    GENIEResponseParameter &GENIEResponse =
+        ResponseToGENIEParameters[c.resp_idx];
+    GENIEResponse.HergSpecs = std::move(HybridFullHergSpecs[c.resp_idx]);
+    NEngines += c.NExtraEngines;
+    FullHERGParameters.push_back(
+        GetSystMetaData()[GENIEResponse.pidx].prettyName);
+  }
+  HybridFullHergSpecs.clear();
+  HybridProfiles.clear();
+
+  BuildWeightEngines(GetSystMetaData(), ResponseToGENIEParameters, EnginePool);
+
+  std::cout << "[INFO]: Hybrid HERG instantiated " << NEngines
+            << " extra GReWeight engines";
+  if (fEngineMemoryMB > 0) {
+    std::cout << " (~" << (NEngines * fEngineMemoryMB) << " MB)";
+  }
+  std::cout << ". To pin this layout, set UseFullHERG: false, HybridHERG: "
+               "false and"
+            << std::endl
+            << "[INFO]:\tFullHERGParameters: [";
+  for (size_t p_it = 0; p_it < FullHERGParameters.size(); ++p_it) {
+    std::cout << (p_it ? ", " : "") << std::quoted(FullHERGParameters[p_it]);
+  }
+  std::cout << "]" << std::endl;
 }
 
 #ifndef NO_ART
@@ -171,95 +524,441 @@ DEFINE_ART_CLASS_TOOL(GENIEReWeight)
 
 systtools::event_unit_response_t
 GENIEReWeight::GetEventResponse(genie::EventRecord const &gev) {
+  return GetEventResponse(gev, EventKinematics(gev));
+}
+
+systtools::event_unit_response_t
+GENIEReWeight::GetEventResponse(genie::EventRecord const &gev,
+                                EventKinematics const &kin) {
 
   systtools::event_unit_response_t event_responses;
   size_t NResps = ResponseToGENIEParameters.size();
 
+  ++fEventSerial;
   for (size_t resp_idx = 0; resp_idx < NResps; ++resp_idx) {
-    event_responses.push_back(GetEventGENIEParameterResponse(gev, resp_idx));
+    event_responses.push_back(
+        GetEventGENIEParameterResponse(gev, kin, resp_idx));
   }
   if (fill_valid_tree) {
-    TLorentzVector FSLepP4 = gev.Summary()->Kine().FSLeptonP4();
-    TLorentzVector ISLepP4 =
-        *gev.Summary()->InitState().GetProbeP4(genie::kRfLab);
-    TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
-
-    Pdgnu = gev.Summary()->InitState().ProbePdg();
-    NEUTMode = 0;
-    if (gev.Summary()->ProcInfo().IsMEC() &&
-        gev.Summary()->ProcInfo().IsWeakCC()) {
-      NEUTMode = (Pdgnu > 0) ? 2 : -2;
-    } else {
-      NEUTMode = genie::utils::ghep::NeutReactionCode(&gev);
+    FillValidTree(kin);
+  }
+  AddHybridHERGProfiledEvents(1);
+
+  return event_responses;
+}
+
+void GENIEReWeight::FillEventResponse(genie::EventRecord const &gev,
+                                      EventKinematics const &kin,
+                                      ResponseBuffer &buf) {
+
+  size_t NResps = ResponseToGENIEParameters.size();
+
+  ++fEventSerial;
+  for (size_t resp_idx = 0; resp_idx < NResps; ++resp_idx) {
+    paramId_t pid =
+        GetSystMetaData()[ResponseToGENIEParameters[resp_idx].pidx].systParamId;
+    FillEventGENIEParameterResponse(gev, kin, resp_idx, buf.Fill(pid));
+  }
+  if (fill_valid_tree) {
+    FillValidTree(kin);
+  }
+  AddHybridHERGProfiledEvents(1);
+}
+
+void GENIEReWeight::GetEventResponses(GHepRecordSpan events,
+                                      batch_response_t &responses) {
+
+  responses.clear();
+  responses.resize(events.size);
+
+  std::vector<EventKinematics> kins;
+  if (!events.HasKinematics()) {
+    kins.reserve(events.size);
+    for (size_t ev_it = 0; ev_it < events.size; ++ev_it) {
+      kins.emplace_back(events[ev_it]);
     }
+    events.kinematics = kins.data();
+  }
 
-    Enu = ISLepP4.E();
-    Q2 = -emTransfer.Mag2();
-    W = gev.Summary()->Kine().W(true);
-    q0 = emTransfer.E();
-    q3 = emTransfer.Vect().Mag();
-    valid_tree->Fill();
+  size_t NResps = ResponseToGENIEParameters.size();
+  for (size_t ev_it = 0; ev_it < events.size; ++ev_it) {
+    responses[ev_it].resize(NResps);
   }
 
-  return event_responses;
+  // Engines that are not reconfigured may be shared between parameters, so
+  // are evaluated event by event to make use of their cached weights.
+  for (size_t ev_it = 0; ev_it < events.size; ++ev_it) {
+    ++fEventSerial;
+    for (size_t resp_idx = 0; resp_idx < NResps; ++resp_idx) {
+      if (!IsBatchReconfigured(resp_idx)) {
+        responses[ev_it][resp_idx] = GetEventGENIEParameterResponse(
+            events[ev_it], events.Kinematics(ev_it), resp_idx);
+      }
+    }
+  }
+  for (size_t resp_idx = 0; resp_idx < NResps; ++resp_idx) {
+    if (IsBatchReconfigured(resp_idx)) {
+      FillBatchGENIEParameterResponses(events, resp_idx, responses);
+    }
+  }
+
+  if (fill_valid_tree) {
+    for (size_t ev_it = 0; ev_it < events.size; ++ev_it) {
+      FillValidTree(events.Kinematics(ev_it));
+    }
+  }
+  AddHybridHERGProfiledEvents(events.size);
 }
 
 double GENIEReWeight::GetEventWeightResponse(
     genie::EventRecord const &gev,
     systtools::param_value_list_t const &set_params) {
+  SetThrow(set_params);
+  return CalcWeight(gev);
+}
 
-  double weight = 1;
+void GENIEReWeight::SetThrow(systtools::param_value_list_t const &set_params) {
 
   fHaveReconfiguredOneOfTheHERG = true;
 
-  for (auto &GENIEResponse : ResponseToGENIEParameters) {
+  size_t NResps = ResponseToGENIEParameters.size();
+  ThrowDialValues.resize(NResps);
+  ThrowAnalyticNormWeights.assign(NResps, 1);
+
+  for (size_t resp_idx = 0; resp_idx < NResps; ++resp_idx) {
+    GENIEResponseParameter &GENIEResponse = ResponseToGENIEParameters[resp_idx];
+    std::vector<double> &dial_values = ThrowDialValues[resp_idx];
+    dial_values.clear();
     for (auto const &dep : GENIEResponse.dependents) {
       SystParamHeader const &hdr = GetSystMetaData()[dep.pidx];
       double pval = hdr.centralParamValue;
       if (ContainterHasParam(set_params, dep.pidx)) {
         pval = GetParamElementFromContainer(set_params, dep.pidx).val;
       }
+      dial_values.push_back(pval);
+    }
 
-      GENIEResponse.Herg.front()->Systematics().Set(dep.gdial, pval);
+    if (GENIEResponse.IsAnalyticNorm && !fValidateAnalyticNormDials) {
+      ThrowAnalyticNormWeights[resp_idx] = GetAnalyticNormWeight(
+          GENIEResponse.dependents.front().gdial, dial_values.front());
+    } else {
+      UnshareFrontEngine(GENIEResponse);
+      GENIEResponse.SetFrontEngineDials(dial_values);
     }
-    GENIEResponse.Herg.front()->Reconfigure();
-    bool is_set_dir = TH1::AddDirectoryStatus();
-    if (!is_set_dir) {
-      TH1::AddDirectory(true);
+  }
+  fThrowIsSet = true;
+}
+
+double GENIEReWeight::CalcWeight(genie::EventRecord const &gev) {
+  return CalcWeight(gev, EventKinematics(gev));
+}
+
+double GENIEReWeight::CalcWeight(genie::EventRecord const &gev,
+                                 EventKinematics const &kin) {
+  if (!fThrowIsSet) {
+    throw invalid_engine_state()
+        << "[ERROR]: GENIEReWeight_tool::CalcWeight called before SetThrow.";
+  }
+
+  double weight = 1;
+
+  size_t NResps = ResponseToGENIEParameters.size();
+  for (size_t resp_idx = 0; resp_idx < NResps; ++resp_idx) {
+    GENIEResponseParameter &GENIEResponse = ResponseToGENIEParameters[resp_idx];
+    if (fUseApplicabilityFilter && !GENIEResponse.IsApplicable(kin)) {
+      continue;
     }
-    weight *= GENIEResponse.Herg.front()->CalcWeight(gev);
-    if (!is_set_dir) {
-      TH1::AddDirectory(false);
+    if (GENIEResponse.IsAnalyticNorm && !fValidateAnalyticNormDials) {
+      if (AnalyticNormDialApplies(GENIEResponse.dependents.front().gdial,
+                                  kin)) {
+        weight *= ThrowAnalyticNormWeights[resp_idx];
+      }
+      continue;
     }
+    // Other calls may have reconfigured the engine since SetThrow.
+    UnshareFrontEngine(GENIEResponse);
+    AddElapsedSeconds(nullptr, GetDialLatency(resp_idx, true, kin.mode),
+                      [&]() {
+                        GENIEResponse.SetFrontEngineDials(
+                            ThrowDialValues[resp_idx]);
+                      });
+    AddElapsedSeconds(nullptr, GetDialLatency(resp_idx, false, kin.mode),
+                      [&]() {
+                        weight *= GENIEResponse.Herg.front()->CalcWeight(gev, 0);
+                      });
   }
 
   return weight;
 }
 
+void GENIEReWeight::UnshareFrontEngine(GENIEResponseParameter &GENIEResponse) {
+  if (GENIEResponse.Herg.front().use_count() < 2) {
+    return;
+  }
+  std::shared_ptr<SharedGReWeight> grw = std::make_shared<SharedGReWeight>();
+  grw->engine = BuildWeightEngine(GENIEResponse.HergSpecs.front());
+  GENIEResponse.Herg.front() = std::move(grw);
+  GENIEResponse.IndexSharedEngines();
+  GENIEResponse.FrontEngineDialValues.clear();
+}
+
+void GENIEReWeight::SetThrowBank(
+    std::vector<systtools::param_value_list_t> const &universes) {
+
+  fHaveReconfiguredOneOfTheHERG = true;
+
+  size_t NResps = ResponseToGENIEParameters.size();
+  NThrowBankUniverses = universes.size();
+  ThrowBank.clear();
+  ThrowBank.resize(NResps);
+
+  // Mean Reconfigure time of the first engine of each parameter that varies
+  // between universes, used to decide which are worth their own engines.
+  std::vector<std::pair<double, size_t>> reconfigure_costs;
+
+  for (size_t resp_idx = 0; resp_idx < NResps; ++resp_idx) {
+    GENIEResponseParameter &GENIEResponse = ResponseToGENIEParameters[resp_idx];
+    ThrowBankParameter &bank = ThrowBank[resp_idx];
+
+    bank.universe_values.reserve(NThrowBankUniverses);
+    for (systtools::param_value_list_t const &set_params : universes) {
+      std::vector<double> dial_values;
+      for (auto const &dep : GENIEResponse.dependents) {
+        SystParamHeader const &hdr = GetSystMetaData()[dep.pidx];
+        double pval = hdr.centralParamValue;
+        if (ContainterHasParam(set_params, dep.pidx)) {
+          pval = GetParamElementFromContainer(set_params, dep.pidx).val;
+        }
+        dial_values.push_back(pval);
+      }
+      size_t d_it = std::find(bank.dial_values.begin(), bank.dial_values.end(),
+                              dial_values) -
+                    bank.dial_values.begin();
+      if (d_it == bank.dial_values.size()) {
+        bank.dial_values.push_back(std::move(dial_values));
+      }
+      bank.universe_values.push_back(d_it);
+    }
+
+    if (GENIEResponse.IsAnalyticNorm && !fValidateAnalyticNormDials) {
+      for (std::vector<double> const &dial_values : bank.dial_values) {
+        bank.analytic_weights.push_back(GetAnalyticNormWeight(
+            GENIEResponse.dependents.front().gdial, dial_values.front()));
+      }
+      continue;
+    }
+
+    UnshareFrontEngine(GENIEResponse);
+    if (bank.dial_values.size() < 2) {
+      continue;
+    }
+    size_t NTimed = std::min(bank.dial_values.size(), size_t(3));
+    double seconds = 0;
+    for (size_t d_it = 0; d_it < NTimed; ++d_it) {
+      AddElapsedSeconds(&seconds, [&]() {
+        GENIEResponse.SetFrontEngineDials(bank.dial_values[d_it]);
+      });
+    }
+    reconfigure_costs.emplace_back(seconds / double(NTimed), resp_idx);
+  }
+
+  // Bank the most expensive parameters first, each costs one engine per
+  // distinct set of dial values.
+  std::stable_sort(reconfigure_costs.begin(), reconfigure_costs.end(),
+                   [](std::pair<double, size_t> const &l,
+                      std::pair<double, size_t> const &r) {
+                     return l.first > r.first;
+                   });
+
+  size_t MaxEngines = tool_options.get<size_t>(
+      "ThrowBankMaxEngines", std::numeric_limits<size_t>::max());
+  size_t NEngines = 0;
+  std::vector<size_t> banked;
+  size_t NReconfigures = 0;
+  for (auto const &cost : reconfigure_costs) {
+    size_t NNeeded = ThrowBank[cost.second].dial_values.size();
+    if ((MaxEngines - NEngines) >= NNeeded) {
+      NEngines += NNeeded;
+      banked.push_back(cost.second);
+    } else {
+      NReconfigures += NNeeded;
+    }
+  }
+
+  std::vector<GReWeightEngineSpec> specs;
+  for (size_t resp_idx : banked) {
+    GENIEResponseParameter const &GENIEResponse =
+        ResponseToGENIEParameters[resp_idx];
+    for (std::vector<double> const &dial_values :
+         ThrowBank[resp_idx].dial_values) {
+      GReWeightEngineSpec spec = GENIEResponse.HergSpecs.front();
+      for (size_t dep_it = 0; dep_it < GENIEResponse.dependents.size();
+           ++dep_it) {
+        genie::rew::GSyst_t gdial = GENIEResponse.dependents[dep_it].gdial;
+        auto dv = std::find_if(
+            spec.dial_values.begin(), spec.dial_values.end(),
+            [&](std::pair<genie::rew::GSyst_t, double> const &v) {
+              return v.first == gdial;
+            });
+        if (dv == spec.dial_values.end()) {
+          spec.dial_values.emplace_back(gdial, dial_values[dep_it]);
+        } else {
+          dv->second = dial_values[dep_it];
+        }
+      }
+      specs.push_back(std::move(spec));
+    }
+  }
+
+  // Universe engines are never reconfigured, so those with identical dials
+  // are shared, including with the full HERG engines of other parameters.
+  std::vector<GReWeightEngineRequest> requests;
+  for (GReWeightEngineSpec const &spec : specs) {
+    requests.push_back({&spec, true});
+  }
+  std::vector<std::shared_ptr<SharedGReWeight>> engines =
+      BuildSharedWeightEngines(requests, EnginePool);
+
+  size_t e_it = 0;
+  for (size_t resp_idx : banked) {
+    ThrowBankParameter &bank = ThrowBank[resp_idx];
+    for (size_t d_it = 0; d_it < bank.dial_values.size(); ++d_it) {
+      bank.engines.push_back(std::move(engines[e_it++]));
+    }
+  }
+
+  std::cout << "[INFO]: Set a throw bank of " << NThrowBankUniverses
+            << " universes, " << banked.size() << " parameters hold "
+            << NEngines << " universe engines and " << NReconfigures
+            << " reconfigures remain per event." << std::endl;
+}
+
+void GENIEReWeight::CalcThrowBankWeights(genie::EventRecord const &gev,
+                                         EventKinematics const &kin,
+                                         std::vector<double> &weights) {
+  if (ThrowBank.size() != ResponseToGENIEParameters.size()) {
+    throw invalid_engine_state() << "[ERROR]: GENIEReWeight_tool::"
+                                    "CalcThrowBankWeights called before "
+                                    "SetThrowBank.";
+  }
+
+  weights.assign(NThrowBankUniverses, 1);
+  ++fEventSerial;
+
+  std::vector<double> value_weights;
+  size_t NResps = ResponseToGENIEParameters.size();
+  for (size_t resp_idx = 0; resp_idx < NResps; ++resp_idx) {
+    GENIEResponseParameter &GENIEResponse = ResponseToGENIEParameters[resp_idx];
+    ThrowBankParameter const &bank = ThrowBank[resp_idx];
+    if (fUseApplicabilityFilter && !GENIEResponse.IsApplicable(kin)) {
+      continue;
+    }
+    if (GENIEResponse.IsAnalyticNorm && !fValidateAnalyticNormDials) {
+      if (!AnalyticNormDialApplies(GENIEResponse.dependents.front().gdial,
+                                   kin)) {
+        continue;
+      }
+      value_weights = bank.analytic_weights;
+    } else {
+      value_weights.resize(bank.dial_values.size());
+      for (size_t d_it = 0; d_it < bank.dial_values.size(); ++d_it) {
+        if (bank.engines.size()) {
+          value_weights[d_it] =
+              bank.engines[d_it]->CalcWeight(gev, fEventSerial);
+        } else {
+          // Other calls may have reconfigured the engine since SetThrowBank.
+          UnshareFrontEngine(GENIEResponse);
+          GENIEResponse.SetFrontEngineDials(bank.dial_values[d_it]);
+          value_weights[d_it] = GENIEResponse.Herg.front()->CalcWeight(gev, 0);
+        }
+      }
+    }
+    for (size_t u_it = 0; u_it < NThrowBankUniverses; ++u_it) {
+      weights[u_it] *= value_weights[bank.universe_values[u_it]];
+    }
+  }
+}
+
 systtools::event_unit_response_t
 GENIEReWeight::GetEventResponse(genie::EventRecord const &gev,
                                 systtools::paramId_t pid) {
 
+  ++fEventSerial;
+
   size_t NResps = ResponseToGENIEParameters.size();
   for (size_t resp_idx = 0; resp_idx < NResps; ++resp_idx) {
     if (GetSystMetaData()[ResponseToGENIEParameters[resp_idx].pidx]
             .systParamId == pid) {
       return systtools::event_unit_response_t{
-          {GetEventGENIEParameterResponse(gev, resp_idx)}};
+          {GetEventGENIEParameterResponse(gev, EventKinematics(gev),
+                                          resp_idx)}};
     }
   }
 
   return systtools::event_unit_response_t();
 }
 
-namespace {
-std::streambuf *default_cout;
-std::ofstream redirect_stream("/dev/null");
-} // namespace
+
+void GENIEReWeight::FillAnalyticNormResponse(
+    GENIEResponseParameter const &GENIEResponse, EventKinematics const &kin,
+    double *responses) {
+  bool applies =
+      AnalyticNormDialApplies(GENIEResponse.dependents.front().gdial, kin);
+  for (size_t var_it = 0; var_it < GENIEResponse.AnalyticNormWeights.size();
+       ++var_it) {
+    responses[var_it] =
+        applies ? GENIEResponse.AnalyticNormWeights[var_it] : 1;
+  }
+}
 
 systtools::ParamResponses
 GENIEReWeight::GetEventGENIEParameterResponse(genie::EventRecord const &gev,
+                                              EventKinematics const &kin,
                                               size_t idx) {
+  systtools::SystParamHeader const &hdr =
+      GetSystMetaData()[ResponseToGENIEParameters[idx].pidx];
+  ParamResponses presp{
+      hdr.systParamId,
+      std::vector<double>(hdr.isCorrection ? 1 : hdr.paramVariations.size())};
+  FillEventGENIEParameterResponse(gev, kin, idx, presp.responses.data());
+  return presp;
+}
+
+void GENIEReWeight::FillEventGENIEParameterResponse(
+    genie::EventRecord const &gev, EventKinematics const &kin, size_t idx,
+    double *responses) {
+
+  GENIEResponseParameter &GENIEResponse = ResponseToGENIEParameters[idx];
+  if (!GENIEResponse.IsAnalyticNorm) {
+    FillEngineGENIEParameterResponse(gev, kin, idx, responses);
+    return;
+  }
+
+  FillAnalyticNormResponse(GENIEResponse, kin, responses);
+  if (!fValidateAnalyticNormDials) {
+    return;
+  }
+
+  std::vector<double> engine_responses(
+      GENIEResponse.AnalyticNormWeights.size());
+  FillEngineGENIEParameterResponse(gev, kin, idx, engine_responses.data());
+  for (size_t var_it = 0; var_it < engine_responses.size(); ++var_it) {
+    double engine_resp = engine_responses[var_it];
+    if (fabs(responses[var_it] - engine_resp) >
+        (1E-6 * std::max(1., fabs(engine_resp)))) {
+      throw analytic_norm_mismatch()
+          << "[ERROR]: Analytic normalization response " << responses[var_it]
+          << " for variation " << var_it << " of parameter "
+          << std::quoted(GetSystMetaData()[GENIEResponse.pidx].prettyName)
+          << " differs from the GENIE engine response " << engine_resp
+          << " for event: " << gev.Summary()->AsString();
+    }
+  }
+}
+
+void GENIEReWeight::FillEngineGENIEParameterResponse(
+    genie::EventRecord const &gev, EventKinematics const &kin, size_t idx,
+    double *responses) {
 
   GENIEResponseParameter &GENIEResponse = ResponseToGENIEParameters[idx];
   systtools::SystParamHeader const &hdr = GetSystMetaData()[GENIEResponse.pidx];
@@ -287,39 +986,76 @@ GENIEReWeight::GetEventGENIEParameterResponse(genie::EventRecord const &gev,
            "GetEventResponse.";
   }
 
-  ParamResponses presp{hdr.systParamId, {}};
+  if (fUseApplicabilityFilter && !GENIEResponse.IsApplicable(kin)) {
+    std::fill(responses, responses + NVars, 1);
+    return;
+  }
+
+  if (!IsReducedHERG && FullHERGPool) {
+    // As some GENIE dials are very slow, variations that share an engine
+    // re-use the first calculation.
+    std::vector<size_t> const &calc_vars = GENIEResponse.HergCalcEngines;
+    std::vector<double> &calc_weights = GENIEResponse.HergCalcWeights;
+
+    // GENIE calculators modify the event's Interaction while they calculate,
+    // e.g. selecting kinematics or flagging free nucleons, so each concurrent
+    // calculation is given its own copy of the event. The GENIE algorithms
+    // that the calculators share are not protected, see FullHERGPool.
+    // The engines of one parameter are timed together, as a single call.
+    AddElapsedSeconds(nullptr, GetDialLatency(idx, false, kin.mode), [&]() {
+      FullHERGPool->ParallelFor(calc_vars.size(), [&](size_t c_it) {
+        ScopedThreadOutputMute mute;
+        genie::EventRecord gev_copy(gev);
+        calc_weights[c_it] = GENIEResponse.Herg[calc_vars[c_it]]->CalcWeight(
+            gev_copy, fEventSerial);
+      });
+    });
+
+    for (size_t var_it = 0; var_it < NVars; ++var_it) {
+      responses[var_it] = calc_weights[GENIEResponse.HergCalcIdx[var_it]];
+    }
+    return;
+  }
 
+  HERGProfile *profile =
+      (fProfilingHybridHERG && IsReducedHERG && HybridFullHergSpecs[idx].size())
+          ? &HybridProfiles[idx]
+          : nullptr;
+
+  std::vector<double> dial_values;
   for (size_t var_it = 0; var_it < NVars; ++var_it) {
 
     if (IsReducedHERG) { // Need a reconfigure for each variation
+      dial_values.clear();
       for (auto const &dep : GENIEResponse.dependents) {
         SystParamHeader const &hdr = GetSystMetaData()[dep.pidx];
-        GENIEResponse.Herg.front()->Systematics().Set(
-            dep.gdial, hdr.isCorrection ? hdr.centralParamValue
-                                        : hdr.paramVariations[var_it]);
+        dial_values.push_back(hdr.isCorrection ? hdr.centralParamValue
+                                               : hdr.paramVariations[var_it]);
+      }
+      AddElapsedSeconds(profile ? &profile->ReconfigureSeconds : nullptr,
+                        GetDialLatency(idx, true, kin.mode),
+                        [&]() { GENIEResponse.SetFrontEngineDials(dial_values); });
 #ifdef GENIEREWEIGHT_GETEVENTRESPONSE_DEBUG
+      for (auto const &dep : GENIEResponse.dependents) {
+        SystParamHeader const &hdr = GetSystMetaData()[dep.pidx];
         std::cout << "\t\t Var = "
                   << (hdr.isCorrection ? hdr.centralParamValue
                                        : hdr.paramVariations[var_it])
                   << " GDial: " << genie::rew::GSyst::AsString(dep.gdial)
                   << " at "
                   << GENIEResponse.Herg.front()
-                         ->Systematics()
+                         ->engine->Systematics()
                          .Info(dep.gdial)
                          ->CurValue
                   << std::endl;
-
-#endif
-      }
-      GENIEResponse.Herg.front()->Reconfigure();
-      bool is_set_dir = TH1::AddDirectoryStatus();
-      if (!is_set_dir) {
-        TH1::AddDirectory(true);
-      }
-      presp.responses.push_back(GENIEResponse.Herg.front()->CalcWeight(gev));
-      if (!is_set_dir) {
-        TH1::AddDirectory(false);
       }
+#endif
+      AddElapsedSeconds(profile ? &profile->CalcWeightSeconds : nullptr,
+                        GetDialLatency(idx, false, kin.mode), [&]() {
+                          responses[var_it] =
+                              GENIEResponse.Herg.front()->CalcWeight(
+                                  gev, fEventSerial);
+                        });
     } else { // Is full HERG, no reconfigure needed
 #ifdef GENIEREWEIGHT_GETEVENTRESPONSE_DEBUG
       for (GENIEResponseParameter::DependentParameter const &dep :
@@ -331,49 +1067,103 @@ GENIEReWeight::GetEventGENIEParameterResponse(genie::EventRecord const &gev,
                   << " GDial: " << genie::rew::GSyst::AsString(dep.gdial)
                   << " at "
                   << GENIEResponse.Herg[var_it]
-                         ->Systematics()
+                         ->engine->Systematics()
                          .Info(dep.gdial)
                          ->CurValue
                   << std::endl;
       }
 #endif
 
-      // As some GENIE dials are very slow, it is worth checking if we have
-      // already calculated this variation before
-      size_t pindx = std::numeric_limits<size_t>::max();
-      for (size_t v_it = 0; v_it < var_it; ++v_it) {
-        if (fabs(hdr.paramVariations[v_it] - hdr.paramVariations[var_it]) <
-            1E-5) {
-          pindx = v_it;
-          break;
-        }
-      }
-      if (pindx !=
-          std::numeric_limits<size_t>::max()) { // Have already calculated this
-        // value, just use that
-        presp.responses.push_back(presp.responses[pindx]);
-      } else { // must calculate
-        bool is_set_dir = TH1::AddDirectoryStatus();
-        if (!is_set_dir) {
-          TH1::AddDirectory(true);
-        }
-
-        ::default_cout = std::cout.rdbuf();
-        std::cout.rdbuf(::redirect_stream.rdbuf());
-        presp.responses.push_back(GENIEResponse.Herg[var_it]->CalcWeight(gev));
-        std::cout.rdbuf(::default_cout);
-
-        if (!is_set_dir) {
-          TH1::AddDirectory(false);
-        }
-      }
+      // As some GENIE dials are very slow, engines that have already been
+      // evaluated for this event, by this or another parameter, return their
+      // cached weight.
+      AddElapsedSeconds(nullptr, GetDialLatency(idx, false, kin.mode), [&]() {
+        ScopedThreadOutputMute mute;
+        responses[var_it] =
+            GENIEResponse.Herg[var_it]->CalcWeight(gev, fEventSerial);
+      });
     }
 #ifdef GENIEREWEIGHT_GETEVENTRESPONSE_DEBUG
-    std::cout << "\t -> " << presp.responses.back() << std::endl;
+    std::cout << "\t -> " << responses[var_it] << std::endl;
 #endif
   }
+}
 
-  return presp;
+bool GENIEReWeight::IsBatchReconfigured(size_t idx) const {
+  GENIEResponseParameter const &GENIEResponse = ResponseToGENIEParameters[idx];
+  systtools::SystParamHeader const &hdr = GetSystMetaData()[GENIEResponse.pidx];
+
+  // Full HERG engines are never reconfigured, there is nothing to share
+  // between events, and analytic parameters have no engine to reconfigure.
+  size_t NVars = hdr.isCorrection ? 1 : hdr.paramVariations.size();
+  return (NVars > GENIEResponse.Herg.size()) && !GENIEResponse.IsAnalyticNorm;
+}
+
+void GENIEReWeight::FillBatchGENIEParameterResponses(
+    GHepRecordSpan events, size_t idx, batch_response_t &responses) {
+
+  GENIEResponseParameter &GENIEResponse = ResponseToGENIEParameters[idx];
+  systtools::SystParamHeader const &hdr = GetSystMetaData()[GENIEResponse.pidx];
+
+  size_t NVars = hdr.isCorrection ? 1 : hdr.paramVariations.size();
+
+  std::vector<size_t> applicable_events;
+  for (size_t ev_it = 0; ev_it < events.size; ++ev_it) {
+    if (!fUseApplicabilityFilter ||
+        GENIEResponse.IsApplicable(events.Kinematics(ev_it))) {
+      applicable_events.push_back(ev_it);
+    }
+  }
+
+  for (size_t ev_it = 0; ev_it < events.size; ++ev_it) {
+    responses[ev_it][idx] = {hdr.systParamId, std::vector<double>(NVars, 1)};
+  }
+  if (!applicable_events.size()) {
+    return;
+  }
+
+  HERGProfile *profile =
+      (fProfilingHybridHERG && HybridFullHergSpecs[idx].size())
+          ? &HybridProfiles[idx]
+          : nullptr;
+
+  std::vector<double> dial_values;
+  for (size_t var_it = 0; var_it < NVars; ++var_it) {
+    dial_values.clear();
+    for (auto const &dep : GENIEResponse.dependents) {
+      SystParamHeader const &dep_hdr = GetSystMetaData()[dep.pidx];
+      dial_values.push_back(dep_hdr.isCorrection
+                                ? dep_hdr.centralParamValue
+                                : dep_hdr.paramVariations[var_it]);
+    }
+    AddElapsedSeconds(profile ? &profile->ReconfigureSeconds : nullptr,
+                      fProfileDials ? &DialProfiles[idx].BatchReconfigure
+                                    : nullptr,
+                      [&]() { GENIEResponse.SetFrontEngineDials(dial_values); });
+
+    AddElapsedSeconds(profile ? &profile->CalcWeightSeconds : nullptr, [&]() {
+      for (size_t ev_it : applicable_events) {
+        AddElapsedSeconds(
+            nullptr,
+            GetDialLatency(idx, false, events.Kinematics(ev_it).mode), [&]() {
+              responses[ev_it][idx].responses[var_it] =
+                  GENIEResponse.Herg.front()->CalcWeight(events[ev_it], 0);
+            });
+      }
+    });
+  }
+}
+
+void GENIEReWeight::FillValidTree(EventKinematics const &kin) {
+  Pdgnu = kin.nu_pdg;
+  NEUTMode = kin.NEUTMode();
+
+  Enu = kin.Enu_GeV;
+  Q2 = kin.Q2_GeV2;
+  W = kin.W_GeV;
+  q0 = kin.q0_GeV;
+  q3 = kin.q3_GeV;
+  valid_tree->Fill();
 }
 
 void GENIEReWeight::InitValidTree() {
@@ -391,7 +1181,81 @@ void GENIEReWeight::InitValidTree() {
   valid_tree->Branch("weights", &weights);
 }
 
+GENIEReWeight::DialProfile const *
+GENIEReWeight::GetDialProfile(systtools::paramId_t pid) const {
+  if (!fProfileDials) {
+    return nullptr;
+  }
+  for (size_t resp_idx = 0; resp_idx < ResponseToGENIEParameters.size();
+       ++resp_idx) {
+    if (GetSystMetaData()[ResponseToGENIEParameters[resp_idx].pidx]
+            .systParamId == pid) {
+      return &DialProfiles[resp_idx];
+    }
+  }
+  return nullptr;
+}
+
+namespace {
+void PrintLatencyStats(std::ostream &os, std::string const &label,
+                       LatencyStats const &stats) {
+  os << "\t\t" << label << ": NCalls = " << stats.GetNCalls()
+     << ", total: " << stats.GetTotalSeconds()
+     << " s, mean: " << (stats.GetMeanSeconds() * 1E6)
+     << " us, p50: " << (stats.GetQuantileSeconds(0.5) * 1E6)
+     << " us, p90: " << (stats.GetQuantileSeconds(0.9) * 1E6)
+     << " us, p99: " << (stats.GetQuantileSeconds(0.99) * 1E6)
+     << " us, max: " << (stats.GetMaxSeconds() * 1E6) << " us." << std::endl;
+}
+} // namespace
+
+void GENIEReWeight::PrintDialProfiles(std::ostream &os) const {
+  // Most expensive parameters first.
+  std::vector<std::pair<double, size_t>> totals;
+  for (size_t resp_idx = 0; resp_idx < DialProfiles.size(); ++resp_idx) {
+    DialProfile const &dp = DialProfiles[resp_idx];
+    double total = dp.BatchReconfigure.GetTotalSeconds();
+    for (auto const &m : dp.Reconfigure) {
+      total += m.second.GetTotalSeconds();
+    }
+    for (auto const &m : dp.CalcWeight) {
+      total += m.second.GetTotalSeconds();
+    }
+    if (total > 0) {
+      totals.emplace_back(total, resp_idx);
+    }
+  }
+  std::stable_sort(totals.begin(), totals.end(),
+                   [](std::pair<double, size_t> const &l,
+                      std::pair<double, size_t> const &r) {
+                     return l.first > r.first;
+                   });
+
+  os << "[INFO]: GENIEReWeight dial latencies:" << std::endl;
+  for (auto const &t : totals) {
+    DialProfile const &dp = DialProfiles[t.second];
+    os << "\t"
+       << GetSystMetaData()[ResponseToGENIEParameters[t.second].pidx]
+              .prettyName
+       << ", total: " << t.first << " s" << std::endl;
+    for (auto const &m : dp.Reconfigure) {
+      PrintLatencyStats(os, "Mode: " + tostr(m.first) + ", Reconfigure",
+                        m.second);
+    }
+    if (dp.BatchReconfigure.GetNCalls()) {
+      PrintLatencyStats(os, "Batch Reconfigure", dp.BatchReconfigure);
+    }
+    for (auto const &m : dp.CalcWeight) {
+      PrintLatencyStats(os, "Mode: " + tostr(m.first) + ", CalcWeight",
+                        m.second);
+    }
+  }
+}
+
 GENIEReWeight::~GENIEReWeight() {
+  if (fProfileDials) {
+    PrintDialProfiles(std::cout);
+  }
   if (valid_file) {
     valid_tree->SetDirectory(valid_file);
     valid_file->Write();
@@ -5,20 +5,36 @@
 
 #include "nusystematics/systproviders/GENIEResponseParameterAssociation.hh"
 
+#include "nusystematics/utility/LatencyStats.hh"
+#include "nusystematics/utility/ThreadPool.hh"
+#include "nusystematics/utility/simbUtility.hh"
+
 // GENIE
 #include "RwFramework/GReWeight.h"
 
 #include "TFile.h"
 #include "TTree.h"
 
+#include <cstdint>
+#include <iosfwd>
+#include <map>
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 // HERG: HIRD OF RAMPAGING GENIES, HIRD: HERG OF INFINITELY REPEATING DEPTH
 
+/// The first instance to be set up changes process-wide state, once: GENIE's
+/// Messenger is set to whisper priorities, TH1::AddDirectory is switched on,
+/// and the buffer of std::cout is wrapped in a ThreadMutableStreambuf, which
+/// is never removed or freed, so that GENIE output from full-HERG
+/// calculations can be muted per thread.
 class GENIEReWeight : public nusyst::IGENIESystProvider_tool {
 public:
   NEW_SYSTTOOLS_EXCEPT(invalid_engine_state);
+  NEW_SYSTTOOLS_EXCEPT(analytic_norm_mismatch);
+  NEW_SYSTTOOLS_EXCEPT(invalid_HERG_layout);
 
   explicit GENIEReWeight(fhicl::ParameterSet const &);
 
@@ -29,33 +45,203 @@ public:
   bool SetupResponseCalculator(fhicl::ParameterSet const &);
 
   systtools::event_unit_response_t GetEventResponse(genie::EventRecord const &);
+  systtools::event_unit_response_t
+  GetEventResponse(genie::EventRecord const &,
+                   nusyst::EventKinematics const &);
+  void FillEventResponse(genie::EventRecord const &,
+                         nusyst::EventKinematics const &,
+                         nusyst::ResponseBuffer &);
+
+  /// Reduced-HERG engines are reconfigured once per variation for the whole
+  /// batch, rather than once per variation per event.
+  void GetEventResponses(nusyst::GHepRecordSpan, nusyst::batch_response_t &);
 
   double GetEventWeightResponse(genie::EventRecord const &,
                                 systtools::param_value_list_t const &);
 
+  /// Only dials whose values differ from those last applied to their engine
+  /// are reconfigured, by SetThrow or lazily by CalcWeight.
+  void SetThrow(systtools::param_value_list_t const &);
+  double CalcWeight(genie::EventRecord const &);
+  double CalcWeight(genie::EventRecord const &,
+                    nusyst::EventKinematics const &);
+
+  /// Builds an engine for each distinct set of dial values across the
+  /// universes for the response parameters that are most expensive to
+  /// reconfigure, within ThrowBankMaxEngines. The remaining parameters
+  /// reconfigure their first engine once per distinct set per event.
+  void SetThrowBank(std::vector<systtools::param_value_list_t> const &);
+  void CalcThrowBankWeights(genie::EventRecord const &,
+                            nusyst::EventKinematics const &,
+                            std::vector<double> &);
+
   systtools::event_unit_response_t GetEventResponse(genie::EventRecord const &,
                                                     systtools::paramId_t);
 
+  std::unique_ptr<nusyst::IGENIESystProvider_tool> Clone() const;
+
+  /// Latencies of the GENIE calls made for one response parameter, by
+  /// interaction mode. Reconfigures shared by a batch of events belong to no
+  /// single mode. Only accumulated when ProfileDials is set, and printed
+  /// when the instance is destroyed.
+  struct DialProfile {
+    std::map<nusyst::simb_mode_copy, nusyst::LatencyStats> Reconfigure;
+    std::map<nusyst::simb_mode_copy, nusyst::LatencyStats> CalcWeight;
+    nusyst::LatencyStats BatchReconfigure;
+  };
+  /// Returns nullptr if this instance was configured without ProfileDials or
+  /// if pid is not one of its response parameters.
+  DialProfile const *GetDialProfile(systtools::paramId_t pid) const;
+  void PrintDialProfiles(std::ostream &) const;
+
   std::string AsString();
 
   ~GENIEReWeight();
 
 private:
+  /// Copies the configuration of another instance and instantiates a new set
+  /// of weight engines, the engines themselves cannot be shared.
+  GENIEReWeight(GENIEReWeight const &);
+
+  void ConfigureWeightEngines(fhicl::ParameterSet const &);
+
   /// Set when GetEventWeightResponse has been used as it reconfigures weight
   /// engines such that GetEventResponse will not perform as expected.
   bool fHaveReconfiguredOneOfTheHERG;
 
+  /// Dial values and analytic normalization weights of the current throw,
+  /// indexed like ResponseToGENIEParameters.
+  bool fThrowIsSet;
+  std::vector<std::vector<double>> ThrowDialValues;
+  std::vector<double> ThrowAnalyticNormWeights;
+
+  /// Responses of events that none of a response parameter's dials apply to
+  /// are set to unity without calling GENIE.
+  bool fUseApplicabilityFilter;
+
+  /// Analytic normalization dials are also calculated with their GENIE
+  /// engines and the two are required to agree.
+  bool fValidateAnalyticNormDials;
+
+  /// Per-dial latency accounting, DialProfiles is indexed like
+  /// ResponseToGENIEParameters.
+  bool fProfileDials;
+  std::vector<DialProfile> DialProfiles;
+  nusyst::LatencyStats *GetDialLatency(size_t idx, bool IsReconfigure,
+                                       nusyst::simb_mode_copy mode) {
+    if (!fProfileDials) {
+      return nullptr;
+    }
+    DialProfile &dp = DialProfiles[idx];
+    return &(IsReconfigure ? dp.Reconfigure : dp.CalcWeight)[mode];
+  }
+
+  /// Reduces every response parameter not named in FullHERGParameters to a
+  /// single reconfigured engine, keeping its full set of specs in
+  /// HybridFullHergSpecs.
+  void ReduceHERGLayout(std::vector<std::string> const &FullHERGParameters);
+
+  /// Builds full engine sets for the profiled response parameters that save
+  /// the most Reconfigure time per extra engine, within the HybridHERG budget,
+  /// and reports the resulting layout.
+  void ChooseHybridHERGLayout();
+
+  /// Cost of the reconfigured engine of a reduced response parameter,
+  /// accumulated over the hybrid HERG profiling events.
+  struct HERGProfile {
+    double ReconfigureSeconds = 0;
+    double CalcWeightSeconds = 0;
+  };
+
+  bool fProfilingHybridHERG;
+  size_t fHybridHERGProfileEvents;
+  size_t fNHybridProfiledEvents;
+  /// Estimated resident memory of one GReWeight engine, 0 if unknown
+  double fEngineMemoryMB;
+  /// Indexed like ResponseToGENIEParameters, empty for parameters that are
+  /// already full or cannot be promoted.
+  std::vector<std::vector<nusyst::GReWeightEngineSpec>> HybridFullHergSpecs;
+  std::vector<HERGProfile> HybridProfiles;
+
+  /// Counts events towards the hybrid HERG profile and chooses the layout
+  /// once enough have been seen.
+  void AddHybridHERGProfiledEvents(size_t NEvents) {
+    if (!fProfilingHybridHERG) {
+      return;
+    }
+    fNHybridProfiledEvents += NEvents;
+    if (fNHybridProfiledEvents >= fHybridHERGProfileEvents) {
+      ChooseHybridHERGLayout();
+    }
+  }
+
   systtools::ParamResponses
-  GetEventGENIEParameterResponse(genie::EventRecord const &, size_t idx);
+  GetEventGENIEParameterResponse(genie::EventRecord const &,
+                                 nusyst::EventKinematics const &, size_t idx);
+  /// Writes the responses of a response parameter, one per variation or a
+  /// single one for corrections, to responses.
+  void FillEventGENIEParameterResponse(genie::EventRecord const &,
+                                       nusyst::EventKinematics const &,
+                                       size_t idx, double *responses);
+  void FillEngineGENIEParameterResponse(genie::EventRecord const &,
+                                        nusyst::EventKinematics const &,
+                                        size_t idx, double *responses);
+  void FillAnalyticNormResponse(nusyst::GENIEResponseParameter const &,
+                                nusyst::EventKinematics const &,
+                                double *responses);
+
+  /// Whether the engine of a response parameter is reconfigured once per
+  /// variation for a whole batch of events.
+  bool IsBatchReconfigured(size_t idx) const;
+  void FillBatchGENIEParameterResponses(nusyst::GHepRecordSpan, size_t idx,
+                                        nusyst::batch_response_t &);
+
+  /// Gives a response parameter a private first engine, if it is shared,
+  /// before that engine is reconfigured.
+  void UnshareFrontEngine(nusyst::GENIEResponseParameter &);
 
   std::vector<nusyst::GENIEResponseParameter> ResponseToGENIEParameters;
 
+  /// Throw bank configuration of one response parameter.
+  struct ThrowBankParameter {
+    /// Distinct dependent dial values across the universes
+    std::vector<std::vector<double>> dial_values;
+    /// Index into dial_values for each universe
+    std::vector<size_t> universe_values;
+    /// One engine per entry of dial_values, empty if the first engine is
+    /// reconfigured instead
+    std::vector<std::shared_ptr<nusyst::SharedGReWeight>> engines;
+    /// Closed-form weight per entry of dial_values for analytic
+    /// normalization parameters
+    std::vector<double> analytic_weights;
+  };
+  /// Indexed like ResponseToGENIEParameters, empty until SetThrowBank.
+  std::vector<ThrowBankParameter> ThrowBank;
+  size_t NThrowBankUniverses;
+
+  /// Engines shared between the response parameters of this instance.
+  nusyst::GReWeightEnginePool EnginePool;
+  /// Identifies the event being evaluated to the weight caches of shared
+  /// engines, incremented for each new event.
+  uint64_t fEventSerial;
+
+  /// Evaluates the per-variation engines of a full-HERG response parameter
+  /// concurrently, only built if FullHERGThreads > 1.
+  ///
+  /// \warning Unsafe: the engines' calculators share process-wide GENIE
+  /// algorithms through the AlgFactory, such as the cross section and nuclear
+  /// models, PDGLibrary and RandomGen, some of which change state while
+  /// calculating. Only the event is copied per task. Off by default, and its
+  /// throughput has not been measured against the serial loop.
+  std::unique_ptr<nusyst::ThreadPool> FullHERGPool;
+
   void extend_ResponseToGENIEParameters(
       std::vector<nusyst::GENIEResponseParameter> &&);
 
   fhicl::ParameterSet tool_options;
 
   void InitValidTree();
+  void FillValidTree(nusyst::EventKinematics const &);
 
   bool fill_valid_tree;
   TFile *valid_file;
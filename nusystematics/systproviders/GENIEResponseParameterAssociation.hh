@@ -1,18 +1,128 @@
 #ifndef nusystematics_SYSTPROVIDERS_GENIERESPONSEPARAMETERASSOCIATION_SEEN
 #define nusystematics_SYSTPROVIDERS_GENIERESPONSEPARAMETERASSOCIATION_SEEN
 
+#include "nusystematics/utility/EventKinematics.hh"
+#include "nusystematics/utility/InteractionMask.hh"
+
 #include "systematicstools/utility/exceptions.hh"
 
 // GENIE
 #include "RwFramework/GReWeight.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace nusyst {
 
 typedef size_t parameter_idx_t;
 
+/// Events for which a GENIE dial can give a weight that differs from unity.
+///
+/// Mirrors, conservatively, the checks that the GENIE weight calculators make
+/// before calculating a weight.
+struct GSystApplicability {
+  enum HadronRequirement {
+    kNoHadronRequirement,
+    kHadronInNucleus,
+    kPionInNucleus,
+    kNucleonInNucleus
+  };
+
+  InteractionMask processes;
+  HadronRequirement hadrons;
+
+  bool Matches(EventKinematics const &kin) const {
+    if (!processes.Matches(kin)) {
+      return false;
+    }
+    switch (hadrons) {
+    case kHadronInNucleus: {
+      return kin.Particles().NHadronInNucleus;
+    }
+    case kPionInNucleus: {
+      return kin.Particles().NPiInNucleus;
+    }
+    case kNucleonInNucleus: {
+      return kin.Particles().NNucleonInNucleus;
+    }
+    default: { return true; }
+    }
+  }
+};
+
+/// A weight calculator to adopt into a GReWeight engine under name.
+///
+/// mode identifies the calculator type and its configuration, which cannot be
+/// recovered from instantiate, so that identical engines can be recognised.
+struct GReWeightCalcSpec {
+  std::string name;
+  std::string mode;
+  std::function<genie::rew::GReWeightI *()> instantiate;
+};
+
+/// Recipe for one GReWeight engine, kept separate from its construction so
+/// that the engines of a whole configuration can be built together.
+struct GReWeightEngineSpec {
+  /// Weight calculators to adopt, in order
+  std::vector<GReWeightCalcSpec> calcs;
+  /// Initial dial values, applied before the engine is first reconfigured
+  std::vector<std::pair<genie::rew::GSyst_t, double>> dial_values;
+
+  /// Specs with equal keys build engines that give identical weights. Dials
+  /// left at zero are equivalent to dials that are not set.
+  std::string GetPoolKey() const {
+    std::stringstream ss;
+    for (GReWeightCalcSpec const &calc : calcs) {
+      ss << calc.name << "/" << calc.mode << ";";
+    }
+    // Later initializations of a dial override earlier ones.
+    std::map<int, double> dials;
+    for (auto const &dv : dial_values) {
+      dials[int(dv.first)] = dv.second;
+    }
+    ss << std::hexfloat;
+    for (auto const &dv : dials) {
+      if (dv.second != 0) {
+        ss << dv.first << "=" << dv.second << ";";
+      }
+    }
+    return ss.str();
+  }
+};
+
+/// A GReWeight engine that may be shared by several response parameters,
+/// along with the weight it last calculated so that it is evaluated only once
+/// per event.
+struct SharedGReWeight {
+  std::unique_ptr<genie::rew::GReWeight> engine;
+  uint64_t cached_event_serial = 0;
+  double cached_weight = 1;
+
+  /// Events are identified by a non-zero serial, 0 bypasses the cache.
+  double CalcWeight(genie::EventRecord const &ev, uint64_t event_serial) {
+    if (!event_serial || (event_serial != cached_event_serial)) {
+      cached_weight = engine->CalcWeight(ev);
+      cached_event_serial = event_serial;
+    }
+    return cached_weight;
+  }
+
+  /// Must be called after the engine is reconfigured.
+  void ForgetCachedWeight() { cached_event_serial = 0; }
+};
+
+/// Engines that are never reconfigured after they are built, by GetPoolKey of
+/// their spec.
+typedef std::map<std::string, std::weak_ptr<SharedGReWeight>>
+    GReWeightEnginePool;
+
 struct GENIEResponseParameter {
   struct DependentParameter {
     genie::rew::GSyst_t gdial;
@@ -20,7 +130,69 @@ struct GENIEResponseParameter {
   };
   parameter_idx_t pidx;
   std::vector<DependentParameter> dependents;
-  std::vector<std::unique_ptr<genie::rew::GReWeight>> Herg;
+  /// One spec per engine in Herg, which is filled by BuildWeightEngines
+  std::vector<GReWeightEngineSpec> HergSpecs;
+  std::vector<std::shared_ptr<SharedGReWeight>> Herg;
+
+  /// The index in Herg of the first use of each distinct engine, and for
+  /// each engine in Herg the position of its first use in HergCalcEngines.
+  /// Rebuilt by IndexSharedEngines whenever Herg changes.
+  std::vector<size_t> HergCalcEngines;
+  std::vector<size_t> HergCalcIdx;
+  /// Scratch for the weights of HergCalcEngines for one event.
+  std::vector<double> HergCalcWeights;
+
+  void IndexSharedEngines() {
+    HergCalcEngines.clear();
+    HergCalcIdx.assign(Herg.size(), 0);
+    for (size_t e_it = 0; e_it < Herg.size(); ++e_it) {
+      HergCalcIdx[e_it] = HergCalcEngines.size();
+      for (size_t f_it = 0; f_it < e_it; ++f_it) {
+        if (Herg[f_it] == Herg[e_it]) {
+          HergCalcIdx[e_it] = HergCalcIdx[f_it];
+          break;
+        }
+      }
+      if (HergCalcIdx[e_it] == HergCalcEngines.size()) {
+        HergCalcEngines.push_back(e_it);
+      }
+    }
+    HergCalcWeights.assign(HergCalcEngines.size(), 1);
+  }
+
+  /// One entry per dependent dial, the response can only differ from unity
+  /// for events matched by at least one.
+  std::vector<GSystApplicability> applicability;
+
+  /// Set for pure normalization dials that are evaluated in closed form, Herg
+  /// is then only filled if the engine path is being used for validation.
+  bool IsAnalyticNorm = false;
+  /// Weight of each variation for events that the dial applies to
+  std::vector<double> AnalyticNormWeights;
+
+  /// Dependent dial values last applied to Herg.front(), empty if unknown
+  std::vector<double> FrontEngineDialValues;
+
+  /// Sets the dependent dials of the first engine and reconfigures it, unless
+  /// it already holds dial_values.
+  void SetFrontEngineDials(std::vector<double> const &dial_values) {
+    if (dial_values == FrontEngineDialValues) {
+      return;
+    }
+    for (size_t d_it = 0; d_it < dependents.size(); ++d_it) {
+      Herg.front()->engine->Systematics().Set(dependents[d_it].gdial,
+                                              dial_values[d_it]);
+    }
+    Herg.front()->engine->Reconfigure();
+    Herg.front()->ForgetCachedWeight();
+    FrontEngineDialValues = dial_values;
+  }
+
+  bool IsApplicable(EventKinematics const &kin) const {
+    return std::any_of(
+        applicability.begin(), applicability.end(),
+        [&](GSystApplicability const &app) { return app.Matches(kin); });
+  }
 };
 
 NEW_SYSTTOOLS_EXCEPT(invalid_GENIE_parameter_index);
@@ -167,22 +167,34 @@ bool MINERvAE2p2h::SetupResponseCalculator(
 
 event_unit_response_t
 MINERvAE2p2h::GetEventResponse(genie::EventRecord const &ev) {
+  return GetEventResponse(ev, EventKinematics(ev));
+}
+
+event_unit_response_t
+MINERvAE2p2h::GetEventResponse(genie::EventRecord const &ev,
+                               EventKinematics const &kin) {
+  return GetEventResponseFromFill(ev, kin);
+}
+
+void MINERvAE2p2h::FillEventResponse(genie::EventRecord const &,
+                                     EventKinematics const &kin,
+                                     ResponseBuffer &buf) {
 
-  event_unit_response_t resp;
   SystMetaData const &md = GetSystMetaData();
 
-  if (!ev.Summary()->ProcInfo().IsMEC() ||
-      !ev.Summary()->ProcInfo().IsWeakCC()) {
-    return this->GetDefaultEventResponse();
+  if ((kin.mode != simb_mode_copy::kMEC) || !kin.is_cc) {
+    FillDefaultEventResponse(buf);
+    return;
   }
 
-  genie::GHepParticle *ISLep = ev.Probe();
-  TLorentzVector ISLepP4 = *ISLep->P4();
-
   size_t pidx_Response, pidx_A, pidx_B;
   std::vector<double> *A_var, *B_var;
   double ACV, BCV;
-  Enu = ISLepP4.E();
+  Enu = kin.Enu_GeV;
+
+  // Filled responses, for the validation tree.
+  double const *filled[4] = {nullptr, nullptr, nullptr, nullptr};
+  size_t NFilled = 0;
 
   for (int const &nu_pdgsign : {+1, -1}) {
 
@@ -194,17 +206,18 @@ MINERvAE2p2h::GetEventResponse(genie::EventRecord const &ev) {
     ACV           = nu_pdgsign>0 ? A_nu_CV               : A_nubar_CV;
     BCV           = nu_pdgsign>0 ? B_nu_CV               : B_nubar_CV;
 
-    bool nuMatched = (ISLep->Pdg() * nu_pdgsign > 0);
+    bool nuMatched = (kin.nu_pdg * nu_pdgsign > 0);
 
     if (!ignore_parameter_dependence) {
 
-      resp.push_back({md[pidx_Response].systParamId, {}});
+      double *out = buf.Fill(md[pidx_Response].systParamId);
+      filled[NFilled++] = out;
 
       for (size_t univ = 0; univ < md[pidx_Response].paramVariations.size();
            ++univ) {
 
         if(!nuMatched){
-          resp.back().responses.push_back(1.);
+          out[univ] = 1.;
           continue;
         }
 
@@ -217,7 +230,7 @@ MINERvAE2p2h::GetEventResponse(genie::EventRecord const &ev) {
         weight = (weight < LimitWeights.first) ? LimitWeights.first : weight;
         weight = (weight > LimitWeights.second) ? LimitWeights.second : weight;
 
-        resp.back().responses.push_back(weight);
+        out[univ] = weight;
       }
 
     } else {
@@ -233,17 +246,19 @@ MINERvAE2p2h::GetEventResponse(genie::EventRecord const &ev) {
           (CVResponse > LimitWeights.second) ? LimitWeights.second : CVResponse;
 
 #ifdef MINERVAE2p2h_DEBUG
-      std::cout << "[CV Response @ " << Enu << ", " << (ISLep->Pdg()) << ", "
+      std::cout << "[CV Response @ " << Enu << ", " << kin.nu_pdg << ", "
                 << ACV << ", " << BCV << "] = " << CVResponse << std::endl;
 #endif
 
       bool UsedADial = false;
       if (pidx_A != kParamUnhandled<size_t>) {
-        resp.push_back({md[pidx_A].systParamId, {}});
-        for (double av : (*A_var)) {
+        double *out = buf.Fill(md[pidx_A].systParamId);
+        filled[NFilled++] = out;
+        for (size_t v_it = 0; v_it < A_var->size(); ++v_it) {
+          double av = (*A_var)[v_it];
 
           if(!nuMatched){
-            resp.back().responses.push_back(1.);
+            out[v_it] = 1.;
             continue;
           }
 
@@ -256,16 +271,18 @@ MINERvAE2p2h::GetEventResponse(genie::EventRecord const &ev) {
           weight = (weight < LimitWeights.first) ? LimitWeights.first : weight;
           weight = (weight > LimitWeights.second) ? LimitWeights.second : weight;
 
-          resp.back().responses.push_back(weight);
+          out[v_it] = weight;
         }
         UsedADial = true;
       }
       if (pidx_B != kParamUnhandled<size_t>) {
-        resp.push_back({md[pidx_B].systParamId, {}});
-        for (double bv : (*B_var)) {
+        double *out = buf.Fill(md[pidx_B].systParamId);
+        filled[NFilled++] = out;
+        for (size_t v_it = 0; v_it < B_var->size(); ++v_it) {
+          double bv = (*B_var)[v_it];
 
           if(!nuMatched){
-            resp.back().responses.push_back(1.);
+            out[v_it] = 1.;
             continue;
           }
 
@@ -282,7 +299,7 @@ MINERvAE2p2h::GetEventResponse(genie::EventRecord const &ev) {
           if (UsedADial) {
             weight /= CVResponse;
           }
-          resp.back().responses.push_back(weight);
+          out[v_it] = weight;
         }
       }
     }
@@ -290,28 +307,28 @@ MINERvAE2p2h::GetEventResponse(genie::EventRecord const &ev) {
   }
 
   if (fill_valid_tree) {
-
-    int Pdgnu = ISLep->Pdg();
-
-    NEUTMode = 0;
-    if (ev.Summary()->ProcInfo().IsMEC() &&
-        ev.Summary()->ProcInfo().IsWeakCC()) {
-      NEUTMode = (Pdgnu > 0) ? 2 : -2;
-    } else {
-      NEUTMode = genie::utils::ghep::NeutReactionCode(&ev);
-    }
-
+    NEUTMode = kin.NEUTMode();
     weight = 1;
 
-    for (auto const &eur : resp) {
-      weight *= eur.responses[2];
+    for (size_t f_it = 0; f_it < NFilled; ++f_it) {
+      weight *= filled[f_it][2];
     }
 
     valid_tree->Fill();
   }
+}
+InteractionMask MINERvAE2p2h::GetApplicability() {
+  return InteractionMask().Add(simb_mode_copy::kMEC, InteractionMask::kCC);
+}
+
+event_unit_response_t MINERvAE2p2h::GetUnmatchedEventResponse() {
+  return GetDefaultEventResponse();
+}
 
-  return resp;
+std::unique_ptr<IGENIESystProvider_tool> MINERvAE2p2h::Clone() const {
+  return std::make_unique<MINERvAE2p2h>(*this);
 }
+
 std::string MINERvAE2p2h::AsString() { return "MINERvAE2p2h"; }
 
 void MINERvAE2p2h::InitValidTree() {
@@ -133,7 +133,7 @@ bool MINERvAq0q3Weighting::SetupResponseCalculator(
              "bug, please report to the maintiner.";
     }
 
-    RPATemplateReweighter = std::make_unique<MINERvARPAq0q3_ReWeight>(
+    RPATemplateReweighter = std::make_shared<MINERvARPAq0q3_ReWeight>(
         tool_options.get<fhicl::ParameterSet>(
             "MINERvATune_RPA_input_manifest"));
   }
@@ -279,33 +279,32 @@ double MINERvAq0q3Weighting::GetMINERvA2p2hTuneEnhancement(
 
 event_unit_response_t
 MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
+  return GetEventResponse(ev, EventKinematics(ev));
+}
 
-  // make default response for configured parameter
-  event_unit_response_t resp;
+event_unit_response_t
+MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev,
+                                       EventKinematics const &kin) {
+  return GetEventResponseFromFill(ev, kin);
+}
 
-  if (!ev.Summary()->ProcInfo().IsWeakCC()) {
-    return this->GetDefaultEventResponse();
-  }
+void MINERvAq0q3Weighting::FillEventResponse(genie::EventRecord const &ev,
+                                             EventKinematics const &kin,
+                                             ResponseBuffer &buf) {
 
-  if (!(ev.Summary()->ProcInfo().IsQuasiElastic() ||
-        ev.Summary()->ProcInfo().IsMEC()) ||
-      ev.Summary()->ExclTag().IsCharmEvent()) {
-    return this->GetDefaultEventResponse();
+  if (!kin.is_cc) {
+    FillDefaultEventResponse(buf);
+    return;
   }
 
-  genie::GHepParticle *FSLep = ev.FinalStatePrimaryLepton();
-  genie::GHepParticle *ISLep = ev.Probe();
-
-  if (!FSLep || !ISLep) {
-    throw incorrectly_generated()
-        << "[ERROR]: Failed to find IS and FS lepton in event: "
-        << ev.Summary()->AsString();
+  bool is_qe_or_mec =
+      (kin.mode == simb_mode_copy::kQE) || (kin.mode == simb_mode_copy::kMEC);
+  if (!is_qe_or_mec || kin.is_charm) {
+    FillDefaultEventResponse(buf);
+    return;
   }
 
-  TLorentzVector FSLepP4 = *FSLep->P4();
-  TLorentzVector ISLepP4 = *ISLep->P4();
-  TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
-  std::array<double, 2> q0q3{{emTransfer.E(), emTransfer.Vect().Mag()}};
+  std::array<double, 2> q0q3{{kin.q0_GeV, kin.q3_GeV}};
 
   if (ConfiguredParameters.find(param_t::kMINERvARPA) !=
       ConfiguredParameters.end()) {
@@ -313,19 +312,22 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
     SystParamHeader const &hdr =
         GetSystMetaData()[ConfiguredParameters[param_t::kMINERvARPA]];
 
-    resp.push_back({hdr.systParamId, {}});
+    double *out = buf.Fill(hdr.systParamId);
     if (hdr.isCorrection) {
-      resp.back().responses.push_back(
-          GetMINERvARPATuneWeight(hdr.centralParamValue, q0q3[0], q0q3[1]));
+      out[0] =
+          GetMINERvARPATuneWeight(hdr.centralParamValue, q0q3[0], q0q3[1]);
     } else {
-      for (double var : hdr.paramVariations) {
-        resp.back().responses.push_back(
-            GetMINERvARPATuneWeight(var, q0q3[0], q0q3[1]));
+      for (size_t v_it = 0; v_it < hdr.paramVariations.size(); ++v_it) {
+        out[v_it] = GetMINERvARPATuneWeight(hdr.paramVariations[v_it],
+                                            q0q3[0], q0q3[1]);
       }
     }
   }
 
-  QELikeTarget_t qel_targ = GetQELikeTarget(ev);
+  if (kin.QELTargetIndeterminable()) { // Rethrow the reason
+    GetQELikeTarget(ev);
+  }
+  QELikeTarget_t qel_targ = kin.QELTarget();
 
   // Only ever applies to 2p2h/qe events
   if ((ConfiguredParameters.find(param_t::kMINERvA2p2h) !=
@@ -335,26 +337,28 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
     SystParamHeader const &hdr =
         GetSystMetaData()[ConfiguredParameters[param_t::kMINERvA2p2h]];
 
-    resp.push_back({hdr.systParamId, {}});
-    for (double var : vals_2p2hTotal) {
+    double *out = buf.Fill(hdr.systParamId);
+    for (size_t v_it = 0; v_it < vals_2p2hTotal.size(); ++v_it) {
+      double var = vals_2p2hTotal[v_it];
       double wght =
           GetMINERvA2p2hTuneEnhancement(var, q0q3[0], q0q3[1], qel_targ);
       wght = (wght < MEC_LimitWeights.first) ? MEC_LimitWeights.first : wght;
       wght = (wght > MEC_LimitWeights.second) ? MEC_LimitWeights.second : wght;
-      resp.back().responses.push_back(wght);
+      out[v_it] = wght;
     }
   }
 
   // Only ever applies to 2p2h events
   if ((ConfiguredParameters.find(param_t::kMINERvA2p2h_CV) !=
        ConfiguredParameters.end()) &&
-      ev.Summary()->ProcInfo().IsMEC()) {
+      (kin.mode == simb_mode_copy::kMEC)) {
 
     SystParamHeader const &hdr =
         GetSystMetaData()[ConfiguredParameters[param_t::kMINERvA2p2h_CV]];
 
-    resp.push_back({hdr.systParamId, {}});
-    for (double v : vals_2p2hCV) {
+    double *out = buf.Fill(hdr.systParamId);
+    for (size_t v_it = 0; v_it < vals_2p2hCV.size(); ++v_it) {
+      double v = vals_2p2hCV[v_it];
       double cv_weight =
           1 + v * GetMINERvA2p2hTuneEnhancement(1, q0q3[0], q0q3[1], qel_targ);
 
@@ -364,7 +368,7 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
                       ? MEC_LimitWeights.second
                       : cv_weight;
 
-      resp.back().responses.push_back(cv_weight);
+      out[v_it] = cv_weight;
     }
   }
   // Only ever applies to 2p2h events
@@ -375,8 +379,9 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
     SystParamHeader const &hdr =
         GetSystMetaData()[ConfiguredParameters[param_t::kMINERvA2p2h_NN]];
 
-    resp.push_back({hdr.systParamId, {}});
-    for (double v : vals_2p2hNN) {
+    double *out = buf.Fill(hdr.systParamId);
+    for (size_t v_it = 0; v_it < vals_2p2hNN.size(); ++v_it) {
+      double v = vals_2p2hNN[v_it];
       double tune_ench =
           v * GetMINERvA2p2hTuneEnhancement(2, q0q3[0], q0q3[1], qel_targ);
 
@@ -386,7 +391,7 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
                       ? MEC_LimitWeights.second
                       : tune_ench;
 
-      resp.back().responses.push_back(tune_ench);
+      out[v_it] = tune_ench;
     }
   }
   // Only ever applies to 2p2h events
@@ -397,8 +402,9 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
     SystParamHeader const &hdr =
         GetSystMetaData()[ConfiguredParameters[param_t::kMINERvA2p2h_np]];
 
-    resp.push_back({hdr.systParamId, {}});
-    for (double v : vals_2p2hnp) {
+    double *out = buf.Fill(hdr.systParamId);
+    for (size_t v_it = 0; v_it < vals_2p2hnp.size(); ++v_it) {
+      double v = vals_2p2hnp[v_it];
       double tune_ench =
           v * GetMINERvA2p2hTuneEnhancement(3, q0q3[0], q0q3[1], qel_targ);
 
@@ -408,7 +414,7 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
                       ? MEC_LimitWeights.second
                       : tune_ench;
 
-      resp.back().responses.push_back(tune_ench);
+      out[v_it] = tune_ench;
     }
   }
   // Only ever applies to qe events
@@ -419,8 +425,9 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
     SystParamHeader const &hdr =
         GetSystMetaData()[ConfiguredParameters[param_t::kMINERvA2p2h_QE]];
 
-    resp.push_back({hdr.systParamId, {}});
-    for (double v : vals_2p2hQE) {
+    double *out = buf.Fill(hdr.systParamId);
+    for (size_t v_it = 0; v_it < vals_2p2hQE.size(); ++v_it) {
+      double v = vals_2p2hQE[v_it];
       double tune_ench =
           v * GetMINERvA2p2hTuneEnhancement(4, q0q3[0], q0q3[1], qel_targ);
 
@@ -430,32 +437,26 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
                       ? MEC_LimitWeights.second
                       : tune_ench;
 
-      resp.back().responses.push_back(tune_ench);
+      out[v_it] = tune_ench;
     }
   }
 
   if (fill_valid_tree) {
 
-    pdgfslep = ev.FinalStatePrimaryLepton()->Pdg();
-    momfslep = FSLepP4.Vect().Mag();
-    cthetafslep = FSLepP4.Vect().CosTheta();
+    pdgfslep = kin.fslep_pdg;
+    momfslep = kin.FSLepP4.Vect().Mag();
+    cthetafslep = kin.FSLepP4.Vect().CosTheta();
 
-    Pdgnu = ISLep->Pdg();
-    NEUTMode = 0;
-    if (ev.Summary()->ProcInfo().IsMEC() &&
-        ev.Summary()->ProcInfo().IsWeakCC()) {
-      NEUTMode = (Pdgnu > 0) ? 2 : -2;
-    } else {
-      NEUTMode = genie::utils::ghep::NeutReactionCode(&ev);
-    }
+    Pdgnu = kin.nu_pdg;
+    NEUTMode = kin.NEUTMode();
 
     QELTarget = e2i(qel_targ);
 
-    Enu = ISLepP4.E();
-    Q2 = -emTransfer.Mag2();
-    W = ev.Summary()->Kine().W(true);
-    q0 = emTransfer.E();
-    q3 = emTransfer.Vect().Mag();
+    Enu = kin.Enu_GeV;
+    Q2 = kin.Q2_GeV2;
+    W = kin.W_GeV;
+    q0 = kin.q0_GeV;
+    q3 = kin.q3_GeV;
 
     RPA_weights.clear();
     MEC_weights.clear();
@@ -465,30 +466,31 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
       paramId_t RPA_param =
           GetSystMetaData()[ConfiguredParameters[param_t::kMINERvARPA]]
               .systParamId;
-      RPA_weights = GetParamElementFromContainer(resp, RPA_param).responses;
+      if (double const *r = buf.GetResponses(RPA_param)) {
+        RPA_weights.assign(r, r + buf.GetNResponses(RPA_param));
+      }
     }
     if ((ConfiguredParameters.find(param_t::kMINERvA2p2h) !=
          ConfiguredParameters.end()) &&
-        (ev.Summary()->ProcInfo().IsQuasiElastic() ||
-         ev.Summary()->ProcInfo().IsMEC())) {
+        is_qe_or_mec) {
       paramId_t MEC_param =
           GetSystMetaData()[ConfiguredParameters[param_t::kMINERvA2p2h]]
               .systParamId;
-      MEC_weights = GetParamElementFromContainer(resp, MEC_param).responses;
+      if (double const *r = buf.GetResponses(MEC_param)) {
+        MEC_weights.assign(r, r + buf.GetNResponses(MEC_param));
+      }
     }
     for (param_t tune_2p2h_universe :
          {param_t::kMINERvA2p2h_CV, param_t::kMINERvA2p2h_NN,
           param_t::kMINERvA2p2h_np, param_t::kMINERvA2p2h_QE}) {
       if ((ConfiguredParameters.find(tune_2p2h_universe) !=
            ConfiguredParameters.end()) &&
-          (ev.Summary()->ProcInfo().IsQuasiElastic() ||
-           ev.Summary()->ProcInfo().IsMEC())) {
+          is_qe_or_mec) {
         paramId_t MEC_param =
             GetSystMetaData()[ConfiguredParameters[tune_2p2h_universe]]
                 .systParamId;
-        size_t idx = GetParamContainerIndex(resp, MEC_param);
-        if (idx != kParamUnhandled<size_t>) {
-          MEC_weights.push_back(resp[idx].responses.front());
+        if (double const *r = buf.GetResponses(MEC_param)) {
+          MEC_weights.push_back(r[0]);
         }
       }
     }
@@ -497,8 +499,20 @@ MINERvAq0q3Weighting::GetEventResponse(genie::EventRecord const &ev) {
     nMEC_weights = MEC_weights.size();
     valid_tree->Fill();
   }
+}
+
+InteractionMask MINERvAq0q3Weighting::GetApplicability() {
+  return InteractionMask()
+      .Add(simb_mode_copy::kQE, InteractionMask::kCC)
+      .Add(simb_mode_copy::kMEC, InteractionMask::kCC);
+}
+
+event_unit_response_t MINERvAq0q3Weighting::GetUnmatchedEventResponse() {
+  return GetDefaultEventResponse();
+}
 
-  return resp;
+std::unique_ptr<IGENIESystProvider_tool> MINERvAq0q3Weighting::Clone() const {
+  return std::make_unique<MINERvAq0q3Weighting>(*this);
 }
 
 std::string MINERvAq0q3Weighting::AsString() { return ""; }
@@ -3,6 +3,8 @@
 
 #include "nusystematics/interface/IGENIESystProvider_tool.hh"
 
+#include "nusystematics/utility/InstanceLocal.hh"
+
 #include "nusystematics/responsecalculators/MINERvARPAq0q3_ReWeight.hh"
 #include "nusystematics/responsecalculators/MINERvAq0q3Weighting_data.hh"
 
@@ -44,7 +46,7 @@ class MINERvAq0q3Weighting : public nusyst::IGENIESystProvider_tool {
     param_t lid;
   };
 
-  std::unique_ptr<nusyst::MINERvARPAq0q3_ReWeight> RPATemplateReweighter;
+  std::shared_ptr<nusyst::MINERvARPAq0q3_ReWeight const> RPATemplateReweighter;
   std::map<param_t, size_t> ConfiguredParameters;
 
 public:
@@ -62,6 +64,17 @@ public:
                                        nusyst::QELikeTarget_t QELTarget);
 
   systtools::event_unit_response_t GetEventResponse(genie::EventRecord const &);
+  systtools::event_unit_response_t
+  GetEventResponse(genie::EventRecord const &,
+                   nusyst::EventKinematics const &);
+  void FillEventResponse(genie::EventRecord const &,
+                         nusyst::EventKinematics const &,
+                         nusyst::ResponseBuffer &);
+
+  nusyst::InteractionMask GetApplicability();
+  systtools::event_unit_response_t GetUnmatchedEventResponse();
+
+  std::unique_ptr<nusyst::IGENIESystProvider_tool> Clone() const;
 
   std::string AsString();
 
@@ -76,9 +89,10 @@ private:
   std::vector<double> vals_2p2hTotal, vals_2p2hCV, vals_2p2hNN, vals_2p2hnp,
       vals_2p2hQE;
 
-  bool fill_valid_tree;
-  TFile *valid_file;
-  TTree *valid_tree;
+  // The validation tree and its branch addresses belong to this instance.
+  nusyst::InstanceLocal<bool> fill_valid_tree;
+  nusyst::InstanceLocal<TFile *> valid_file;
+  nusyst::InstanceLocal<TTree *> valid_tree;
 
   bool parameter_per_2p2h_universe;
 
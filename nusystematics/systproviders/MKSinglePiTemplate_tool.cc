@@ -153,9 +153,12 @@ bool MKSinglePiTemplate::SetupResponseCalculator(
     }
 
     TemplateHelper th;
-    th.Template = std::make_unique<MKSinglePiTemplate_ReWeight>(
-        templateManifest.get<fhicl::ParameterSet>(ch.name));
-    th.ZeroIsValid = th.Template->IsValidVariation(0);
+    th.Template = std::make_shared<MKSinglePiTemplate_ReWeight>(
+        InheritTemplateBankOptions(
+            templateManifest,
+            templateManifest.get<fhicl::ParameterSet>(ch.name)));
+    th.VariationSlots = th.Template->ResolveVariationIndices(
+        GetSystMetaData()[ResponseParameterIdx].paramVariations);
 
     ChannelParameterMapping.emplace(ch.channel, std::move(th));
   }
@@ -182,66 +185,115 @@ bool MKSinglePiTemplate::SetupResponseCalculator(
 
 event_unit_response_t
 MKSinglePiTemplate::GetEventResponse(genie::EventRecord const &ev) {
+  return GetEventResponse(ev, EventKinematics(ev));
+}
+
+event_unit_response_t
+MKSinglePiTemplate::GetEventResponse(genie::EventRecord const &ev,
+                                     EventKinematics const &kin) {
 
   event_unit_response_t resp;
 
-  if (!ev.Summary()->ProcInfo().IsWeakCC()) {
+  SystParamHeader const &hdr = GetSystMetaData()[ResponseParameterIdx];
+
+  genie::SppChannel_t chan = genie::kSppNull;
+
+  std::vector<double> responses(hdr.paramVariations.size());
+  if (!CalcResponses(ev, kin, chan, responses.data())) {
     return resp;
   }
+  resp.push_back({hdr.systParamId, std::move(responses)});
 
-  bool is_res = ev.Summary()->ProcInfo().IsResonant();
+  if (fill_valid_tree) {
 
-  if (!(is_res || ev.Summary()->ProcInfo().IsDeepInelastic())) {
-    return resp;
+    q0_nuc_rest_frame = kin.q0_nuc_rest_frame_GeV();
+    q3_nuc_rest_frame = kin.q3_nuc_rest_frame_GeV();
+    Enu_nuc_rest_frame = kin.Enu_nuc_rest_frame_GeV();
+
+    pdgfslep = kin.fslep_pdg;
+    momfslep = kin.FSLepP4.Vect().Mag();
+    cthetafslep = kin.FSLepP4.Vect().CosTheta();
+
+    Pdgnu = kin.nu_pdg;
+    NEUTMode = kin.NEUTMode();
+    IsDIS = (kin.mode == simb_mode_copy::kDIS);
+
+    SppChannel = chan;
+
+    pdghmfspi = kin.Particles().LeadingPi_pdg;
+    momhmfspi = kin.Particles().LeadingPi_p_GeV;
+    cthetahmfspi = kin.Particles().LeadingPi_CosTheta;
+
+    weight = resp.back().responses.back();
+
+    Enu = kin.Enu_GeV;
+    Q2 = kin.Q2_GeV2;
+    W = kin.W_GeV;
+    q0 = kin.q0_GeV;
+    q3 = kin.q3_GeV;
+
+    valid_tree->Fill();
   }
 
-  if (ev.Summary()->Kine().W(true) > 1.7) {
-    return resp;
+  return resp;
+}
+
+void MKSinglePiTemplate::FillEventResponse(genie::EventRecord const &ev,
+                                           EventKinematics const &kin,
+                                           ResponseBuffer &buf) {
+  if (fill_valid_tree) {
+    IGENIESystProvider_tool::FillEventResponse(ev, kin, buf);
+    return;
+  }
+
+  paramId_t pid = GetSystMetaData()[ResponseParameterIdx].systParamId;
+  genie::SppChannel_t chan;
+  if (CalcResponses(ev, kin, chan, buf.GetWriteBuffer(pid))) {
+    buf.SetFilled(pid);
   }
+}
 
-  bool is_nu = (ev.Probe()->Pdg() > 0);
+bool MKSinglePiTemplate::CalcResponses(
+    [[maybe_unused]] genie::EventRecord const &ev, EventKinematics const &kin,
+    genie::SppChannel_t &chan, double *out) {
+
+  chan = genie::kSppNull;
+
+  if (!kin.is_cc) {
+    return false;
+  }
+
+  bool is_res = (kin.mode == simb_mode_copy::kRes);
+
+  if (!(is_res || (kin.mode == simb_mode_copy::kDIS))) {
+    return false;
+  }
+
+  if (kin.W_GeV > 1.7) {
+    return false;
+  }
+
+  bool is_nu = (kin.nu_pdg > 0);
 
   // Only suppress non-resonant background channels when we have templates to
   // reweight to.
   if (!is_res && ((is_nu && !SuppressNeutrinoBkgSPP) ||
                   (!is_nu && !SuppressAntiNeutrinoBkgSPP))) {
-    return resp;
+    return false;
   }
 
   SystParamHeader const &hdr = GetSystMetaData()[ResponseParameterIdx];
+  size_t NVars = hdr.paramVariations.size();
 
-  genie::SppChannel_t chan = genie::kSppNull;
-
-  genie::Target const &tgt = ev.Summary()->InitState().Tgt();
-  if (!tgt.HitNucIsSet()) {
+  if (!kin.HitNucIsSet()) {
     throw incorrectly_generated()
         << "[ERROR]: Failed to get hit nucleon kinematics as it was not "
            "included in this GHep event. This is a fatal error.";
   }
 
-  TLorentzVector NucP4 = tgt.HitNucP4();
-
-  genie::GHepParticle *FSLep = ev.FinalStatePrimaryLepton();
-  genie::GHepParticle *ISLep = ev.Probe();
-
-  if (!FSLep || !ISLep) {
-    throw incorrectly_generated()
-        << "[ERROR]: Failed to find IS and FS lepton in event: "
-        << ev.Summary()->AsString();
-  }
-
-  TLorentzVector FSLepP4 = *FSLep->P4();
-  TLorentzVector ISLepP4 = *ISLep->P4();
+  if (is_res) {
 
-  FSLepP4.Boost(-NucP4.BoostVector());
-  ISLepP4.Boost(-NucP4.BoostVector());
-  NucP4.Boost(-NucP4.BoostVector());
-
-  TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
-
-  if (ev.Summary()->ProcInfo().IsResonant()) {
-
-    chan = SPPChannelFromGHep(ev);
+    chan = kin.SPPChannel();
 
     if ((chan == genie::kSppNull) ||
         (ChannelParameterMapping.find(chan) == ChannelParameterMapping.end())) {
@@ -253,105 +305,56 @@ MKSinglePiTemplate::GetEventResponse(genie::EventRecord const &ev) {
           || (neut_code == 23) // Kaon-production
           || (neut_code == 17) // gamma-production
       ) {
-        return resp;
+        return false;
       }
       std::cout << "[INFO]: RES event failed to find SPP Channel  (NEUT: "
                 << genie::utils::ghep::NeutReactionCode(&ev) << ") "
                 << std::endl
                 << DumpGENIEEv(ev) << std::endl;
 #endif
-      return resp;
+      return false;
     }
 
     std::array<double, 2> kinematics;
-    kinematics[0] = use_Q2W_templates ? -emTransfer.Mag2() : emTransfer.E();
-    kinematics[1] = use_Q2W_templates ? ev.Summary()->Kine().W(true)
-                                      : emTransfer.Vect().Mag();
+    kinematics[0] = use_Q2W_templates ? kin.Q2_nuc_rest_frame_GeV2()
+                                      : kin.q0_nuc_rest_frame_GeV();
+    kinematics[1] =
+        use_Q2W_templates ? kin.W_GeV : kin.q3_nuc_rest_frame_GeV();
 
     if (Q2_or_q0_is_x) {
       std::swap(kinematics[0], kinematics[1]);
     }
 
-    resp.push_back({hdr.systParamId, {}});
-    for (double val : hdr.paramVariations) {
-
-      if ((val == 0) && !ChannelParameterMapping[chan].ZeroIsValid) {
-        resp.back().responses.push_back(1);
-      } else {
-        resp.back().responses.push_back(
-            ChannelParameterMapping[chan].Template->GetVariation(
-                val, ISLepP4.E(), kinematics));
-      }
+    TemplateHelper const &th = ChannelParameterMapping[chan];
+    // Every variation is read from the same template bin.
+    auto bin = th.Template->GetBin(kin.Enu_nuc_rest_frame_GeV(), kinematics);
+    for (size_t v_it = 0; v_it < NVars; ++v_it) {
+      out[v_it] =
+          th.Template->GetVariationByIndex(th.VariationSlots, v_it, bin);
     }
   } else { // Non-resonant background has to die off as MK is turned on, as the
            // MK prediction includes the coupled background channels
-    resp.push_back({hdr.systParamId, {}});
-    for (double val : hdr.paramVariations) {
-      val = std::min(fabs(val), 1.0);
-      resp.back().responses.push_back(1 - val);
+    for (size_t v_it = 0; v_it < NVars; ++v_it) {
+      double val = std::min(fabs(hdr.paramVariations[v_it]), 1.0);
+      out[v_it] = 1 - val;
     }
   }
 
-  if (fill_valid_tree) {
-
-    q0_nuc_rest_frame = emTransfer.E();
-    q3_nuc_rest_frame = emTransfer.Vect().Mag();
-    Enu_nuc_rest_frame = ISLepP4.E();
-
-    ISLepP4 = *ISLep->P4();
-    FSLepP4 = *FSLep->P4();
-    emTransfer = (ISLepP4 - FSLepP4);
-
-    pdgfslep = ev.FinalStatePrimaryLepton()->Pdg();
-    momfslep = FSLepP4.Vect().Mag();
-    cthetafslep = FSLepP4.Vect().CosTheta();
-
-    Pdgnu = ISLep->Pdg();
-    NEUTMode = 0;
-    if (ev.Summary()->ProcInfo().IsMEC() &&
-        ev.Summary()->ProcInfo().IsWeakCC()) {
-      NEUTMode = (Pdgnu > 0) ? 2 : -2;
-    } else {
-      NEUTMode = genie::utils::ghep::NeutReactionCode(&ev);
-    }
-    IsDIS = ev.Summary()->ProcInfo().IsDeepInelastic();
-
-    SppChannel = chan;
-
-    momhmfspi = 0;
-    size_t NParts = ev.GetEntries();
-    for (size_t it = 0; it < NParts; ++it) {
-      genie::GHepParticle *part = ev.Particle(it);
-      if (part->Status() != genie::kIStStableFinalState) {
-        continue;
-      }
-      if ((part->Pdg() != 211) && (part->Pdg() != 111)) {
-        continue;
-      }
-      if (momhmfspi < part->P4()->Vect().Mag()) {
-        pdghmfspi = part->Pdg();
-        momhmfspi = part->P4()->Vect().Mag();
-        cthetahmfspi = part->P4()->Vect().CosTheta();
-      }
-    }
-
-    weight = resp.back().responses.back();
-
-    Enu = ISLepP4.E();
-    Q2 = -emTransfer.Mag2();
-    W = ev.Summary()->Kine().W(true);
-    q0 = emTransfer.E();
-    q3 = emTransfer.Vect().Mag();
+  return true;
+}
 
-    std::array<double, 2> kinematics;
-    kinematics[0] = use_Q2W_templates ? -emTransfer.Mag2() : emTransfer.E();
-    kinematics[1] = use_Q2W_templates ? ev.Summary()->Kine().W(true)
-                                      : emTransfer.Vect().Mag();
 
-    valid_tree->Fill();
-  }
+InteractionMask MKSinglePiTemplate::GetApplicability() {
+  // Non-resonant SPP backgrounds are only touched when suppressed.
+  int bkg_nutypes = (SuppressNeutrinoBkgSPP ? InteractionMask::kNu : 0) |
+                    (SuppressAntiNeutrinoBkgSPP ? InteractionMask::kNuBar : 0);
+  return InteractionMask()
+      .Add(simb_mode_copy::kRes, InteractionMask::kCC)
+      .Add(simb_mode_copy::kDIS, InteractionMask::kCC, bkg_nutypes);
+}
 
-  return resp;
+std::unique_ptr<IGENIESystProvider_tool> MKSinglePiTemplate::Clone() const {
+  return std::make_unique<MKSinglePiTemplate>(*this);
 }
 
 std::string MKSinglePiTemplate::AsString() { return ""; }
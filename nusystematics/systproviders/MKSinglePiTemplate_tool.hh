@@ -3,6 +3,8 @@
 
 #include "nusystematics/interface/IGENIESystProvider_tool.hh"
 
+#include "nusystematics/utility/InstanceLocal.hh"
+
 #include "nusystematics/responsecalculators/MKSinglePiTemplate_ReWeight.hh"
 
 // GENIE
@@ -19,8 +21,9 @@ class MKSinglePiTemplate : public nusyst::IGENIESystProvider_tool {
   size_t ResponseParameterIdx;
 
   struct TemplateHelper {
-    std::unique_ptr<nusyst::MKSinglePiTemplate_ReWeight> Template;
-    bool ZeroIsValid;
+    std::shared_ptr<nusyst::MKSinglePiTemplate_ReWeight const> Template;
+    /// Template slot of each parameter variation, per Enu bin
+    nusyst::MKSinglePiTemplate_ReWeight::variation_indices_t VariationSlots;
   };
 
   std::map<genie::SppChannel_t, TemplateHelper>
@@ -36,6 +39,16 @@ public:
                                             systtools::paramId_t);
 
   systtools::event_unit_response_t GetEventResponse(genie::EventRecord const &);
+  systtools::event_unit_response_t
+  GetEventResponse(genie::EventRecord const &,
+                   nusyst::EventKinematics const &);
+  void FillEventResponse(genie::EventRecord const &,
+                         nusyst::EventKinematics const &,
+                         nusyst::ResponseBuffer &);
+
+  nusyst::InteractionMask GetApplicability();
+
+  std::unique_ptr<nusyst::IGENIESystProvider_tool> Clone() const;
 
   std::string AsString();
 
@@ -48,11 +61,19 @@ private:
 
   fhicl::ParameterSet tool_options;
 
+  /// Writes one response per parameter variation to out, returns false
+  /// without writing if the event is unaffected. chan is set to the SPP
+  /// channel of resonant events.
+  bool CalcResponses(genie::EventRecord const &,
+                     nusyst::EventKinematics const &, genie::SppChannel_t &chan,
+                     double *out);
+
   void InitValidTree();
 
-  bool fill_valid_tree;
-  TFile *valid_file;
-  TTree *valid_tree;
+  // The validation tree and its branch addresses belong to this instance.
+  nusyst::InstanceLocal<bool> fill_valid_tree;
+  nusyst::InstanceLocal<TFile *> valid_file;
+  nusyst::InstanceLocal<TTree *> valid_tree;
 
   bool SuppressNeutrinoBkgSPP;
   bool SuppressAntiNeutrinoBkgSPP;
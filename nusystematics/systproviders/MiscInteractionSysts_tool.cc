@@ -81,189 +81,151 @@ bool MiscInteractionSysts::SetupResponseCalculator(
   return true;
 }
 
-std::vector<double> MiscInteractionSysts::GetWeights_C12ToAr40_2p2hScaling(
-    genie::EventRecord const &ev, std::vector<double> const &vals) {
+void MiscInteractionSysts::FillWeights_C12ToAr40_2p2hScaling(
+    genie::EventRecord const &ev, EventKinematics const &kin,
+    std::vector<double> const &vals, double *out) {
 
-  std::vector<double> resp;
-
-  QELikeTarget_t mec_topology = GetQELikeTarget(ev);
+  if (kin.QELTargetIndeterminable()) { // Re-run for the diagnostic exception.
+    GetQELikeTarget(ev);
+  }
+  QELikeTarget_t mec_topology = kin.QELTarget();
 
   if ((mec_topology == nusyst::QELikeTarget_t::kQE) ||
       (mec_topology == nusyst::QELikeTarget_t::kInvalidTopology)) {
-    return std::vector<double>(vals.size(), 1.);
+    std::fill(out, out + vals.size(), 1.);
+    return;
   }
 
-  for (double v : vals) {
-    resp.push_back(GetC_Ar2p2hScalingWeight(v));
+  for (size_t v_it = 0; v_it < vals.size(); ++v_it) {
+    out[v_it] = GetC_Ar2p2hScalingWeight(vals[v_it]);
   }
-
-  return resp;
 }
 
-std::vector<double> MiscInteractionSysts::GetWeights_nuenuebar_xsec_ratio(
-    genie::EventRecord const &ev, std::vector<double> const &vals) {
+void MiscInteractionSysts::FillWeights_nuenuebar_xsec_ratio(
+    EventKinematics const &kin, std::vector<double> const &vals,
+    double *out) {
 
-  std::vector<double> resp;
-
-  genie::GHepParticle *ISLep = ev.Probe();
-  if (abs(ISLep->Pdg()) != 12) {
-    return std::vector<double>(vals.size(), 1.);
+  if (abs(kin.nu_pdg) != 12) {
+    std::fill(out, out + vals.size(), 1.);
+    return;
   }
 
-  if (!ev.Summary()->ProcInfo().IsWeakCC()) {
-    return std::vector<double>(vals.size(), 1.);
+  if (!kin.is_cc) {
+    std::fill(out, out + vals.size(), 1.);
+    return;
   }
 
-  int pdgnu = ISLep->Pdg();
-  double enu = ISLep->P4()->E();
-
-  for (double v : vals) {
-    resp.push_back(GetNueNueBarXSecRatioWeight(pdgnu, true, enu, v));
+  for (size_t v_it = 0; v_it < vals.size(); ++v_it) {
+    out[v_it] =
+        GetNueNueBarXSecRatioWeight(kin.nu_pdg, true, kin.Enu_GeV, vals[v_it]);
   }
-
-  return resp;
 }
-std::vector<double> MiscInteractionSysts::GetWeights_nuenumu_xsec_ratio(
-    genie::EventRecord const &ev, std::vector<double> const &vals) {
-
-  std::vector<double> resp;
+void MiscInteractionSysts::FillWeights_nuenumu_xsec_ratio(
+    EventKinematics const &kin, std::vector<double> const &vals,
+    double *out) {
 
-  genie::GHepParticle *ISLep = ev.Probe();
-  if (abs(ISLep->Pdg()) != 12) {
-    return std::vector<double>(vals.size(), 1.);
+  if (abs(kin.nu_pdg) != 12) {
+    std::fill(out, out + vals.size(), 1.);
+    return;
   }
 
-  if (!ev.Summary()->ProcInfo().IsWeakCC()) {
-    return std::vector<double>(vals.size(), 1.);
+  if (!kin.is_cc) {
+    std::fill(out, out + vals.size(), 1.);
+    return;
   }
 
-  int pdgnu = ISLep->Pdg();
-
-  TLorentzVector ISLepP4 = *ISLep->P4();
-
-  double enu = ISLepP4.E();
-
-  TLorentzVector FSLepP4 = *ev.FinalStatePrimaryLepton()->P4();
-
-  TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
-
-  double q0_GeV = emTransfer.E();
-  double q3_GeV = emTransfer.Vect().Mag();
-
-  for (double v : vals) {
-    resp.push_back(GetNueNumuRatioWeight(pdgnu, true, enu, q0_GeV, q3_GeV, v));
+  for (size_t v_it = 0; v_it < vals.size(); ++v_it) {
+    out[v_it] = GetNueNumuRatioWeight(kin.nu_pdg, true, kin.Enu_GeV,
+                                      kin.q0_GeV, kin.q3_GeV, vals[v_it]);
   }
-
-  return resp;
 }
-std::vector<double> MiscInteractionSysts::GetWeights_SPPLowQ2Suppression(
-    genie::EventRecord const &ev, std::vector<double> const &vals) {
-
-  std::vector<double> resp;
+void MiscInteractionSysts::FillWeights_SPPLowQ2Suppression(
+    EventKinematics const &kin, std::vector<double> const &vals,
+    double *out) {
 
-  if (SPPChannelFromGHep(ev) == genie::kSppNull) {
-    return std::vector<double>(vals.size(), 1.);
+  if (kin.SPPChannel() == genie::kSppNull) {
+    std::fill(out, out + vals.size(), 1.);
+    return;
   }
 
-  TLorentzVector ISLepP4 = *ev.Probe()->P4();
-
-  TLorentzVector FSLepP4 = *ev.FinalStatePrimaryLepton()->P4();
-
-  TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
-  double Q2_GeV = -emTransfer.Mag2();
-
-  for (double v : vals) {
-    resp.push_back(GetMINERvASPPLowQ2SuppressionWeight(e2i(GetSimbMode(ev)),
-                                                       true, Q2_GeV, v));
+  for (size_t v_it = 0; v_it < vals.size(); ++v_it) {
+    out[v_it] = GetMINERvASPPLowQ2SuppressionWeight(e2i(kin.mode), true,
+                                                    kin.Q2_GeV2, vals[v_it]);
   }
-
-  return resp;
 }
 
 systtools::event_unit_response_t
 MiscInteractionSysts::GetEventResponse(genie::EventRecord const &ev) {
+  return GetEventResponse(ev, EventKinematics(ev));
+}
 
-  systtools::event_unit_response_t resp;
+systtools::event_unit_response_t
+MiscInteractionSysts::GetEventResponse(genie::EventRecord const &ev,
+                                       EventKinematics const &kin) {
+  return GetEventResponseFromFill(ev, kin);
+}
+
+void MiscInteractionSysts::FillEventResponse(genie::EventRecord const &ev,
+                                             EventKinematics const &kin,
+                                             ResponseBuffer &buf) {
 
   systtools::SystMetaData const &md = GetSystMetaData();
 
-  if (pidx_C12ToAr40_2p2hScaling_nu != systtools::kParamUnhandled<size_t>) {
-    std::vector<double> wght = (ev.Probe()->Pdg() > 0) ? GetWeights_C12ToAr40_2p2hScaling(ev, md[pidx_C12ToAr40_2p2hScaling_nu].paramVariations)
-                                                       : std::vector<double>(md[pidx_C12ToAr40_2p2hScaling_nu].paramVariations.size(), 1.);
-    if (wght.size()) {
-      resp.push_back(
-          {md[pidx_C12ToAr40_2p2hScaling_nu].systParamId, std::move(wght)});
+  // Parameters without variations have no response.
+  if ((pidx_C12ToAr40_2p2hScaling_nu != systtools::kParamUnhandled<size_t>) &&
+      md[pidx_C12ToAr40_2p2hScaling_nu].paramVariations.size()) {
+    systtools::SystParamHeader const &hdr = md[pidx_C12ToAr40_2p2hScaling_nu];
+    double *out = buf.Fill(hdr.systParamId);
+    if (kin.nu_pdg > 0) {
+      FillWeights_C12ToAr40_2p2hScaling(ev, kin, hdr.paramVariations, out);
+    } else {
+      std::fill(out, out + hdr.paramVariations.size(), 1.);
     }
   }
-  if (pidx_C12ToAr40_2p2hScaling_nubar != systtools::kParamUnhandled<size_t>) {
-    std::vector<double> wght = (ev.Probe()->Pdg() < 0) ? GetWeights_C12ToAr40_2p2hScaling(ev, md[pidx_C12ToAr40_2p2hScaling_nubar].paramVariations)
-                                                       : std::vector<double>(md[pidx_C12ToAr40_2p2hScaling_nubar].paramVariations.size(), 1.);
-    if (wght.size()) {
-      resp.push_back(
-          {md[pidx_C12ToAr40_2p2hScaling_nubar].systParamId, std::move(wght)});
+  if ((pidx_C12ToAr40_2p2hScaling_nubar !=
+       systtools::kParamUnhandled<size_t>) &&
+      md[pidx_C12ToAr40_2p2hScaling_nubar].paramVariations.size()) {
+    systtools::SystParamHeader const &hdr =
+        md[pidx_C12ToAr40_2p2hScaling_nubar];
+    double *out = buf.Fill(hdr.systParamId);
+    if (kin.nu_pdg < 0) {
+      FillWeights_C12ToAr40_2p2hScaling(ev, kin, hdr.paramVariations, out);
+    } else {
+      std::fill(out, out + hdr.paramVariations.size(), 1.);
     }
   }
-  if (pidx_nuenuebar_xsec_ratio != systtools::kParamUnhandled<size_t>) {
-    std::vector<double> wght = GetWeights_nuenuebar_xsec_ratio(
-        ev, md[pidx_nuenuebar_xsec_ratio].paramVariations);
-    if (wght.size()) {
-      resp.push_back(
-          {md[pidx_nuenuebar_xsec_ratio].systParamId, std::move(wght)});
-    }
+  if ((pidx_nuenuebar_xsec_ratio != systtools::kParamUnhandled<size_t>) &&
+      md[pidx_nuenuebar_xsec_ratio].paramVariations.size()) {
+    systtools::SystParamHeader const &hdr = md[pidx_nuenuebar_xsec_ratio];
+    FillWeights_nuenuebar_xsec_ratio(kin, hdr.paramVariations,
+                                     buf.Fill(hdr.systParamId));
   }
-  if (pidx_nuenumu_xsec_ratio != systtools::kParamUnhandled<size_t>) {
-    std::vector<double> wght = GetWeights_nuenumu_xsec_ratio(
-        ev, md[pidx_nuenumu_xsec_ratio].paramVariations);
-    if (wght.size()) {
-      resp.push_back(
-          {md[pidx_nuenumu_xsec_ratio].systParamId, std::move(wght)});
-    }
+  if ((pidx_nuenumu_xsec_ratio != systtools::kParamUnhandled<size_t>) &&
+      md[pidx_nuenumu_xsec_ratio].paramVariations.size()) {
+    systtools::SystParamHeader const &hdr = md[pidx_nuenumu_xsec_ratio];
+    FillWeights_nuenumu_xsec_ratio(kin, hdr.paramVariations,
+                                   buf.Fill(hdr.systParamId));
   }
-  if (pidx_SPPLowQ2Suppression != systtools::kParamUnhandled<size_t>) {
-    std::vector<double> wght = GetWeights_SPPLowQ2Suppression(
-        ev, md[pidx_SPPLowQ2Suppression].paramVariations);
-    if (wght.size()) {
-      resp.push_back(
-          {md[pidx_SPPLowQ2Suppression].systParamId, std::move(wght)});
-    }
-  }
-
-  // Remove any empty responses
-  for (size_t r_it = 0; r_it < resp.size();) {
-    if (!resp[r_it].responses.size()) {
-      resp.erase(resp.begin() + r_it);
-    } else {
-      ++r_it;
-    }
+  if ((pidx_SPPLowQ2Suppression != systtools::kParamUnhandled<size_t>) &&
+      md[pidx_SPPLowQ2Suppression].paramVariations.size()) {
+    systtools::SystParamHeader const &hdr = md[pidx_SPPLowQ2Suppression];
+    FillWeights_SPPLowQ2Suppression(kin, hdr.paramVariations,
+                                    buf.Fill(hdr.systParamId));
   }
 
   if (fill_valid_tree) {
-    genie::GHepParticle *FSLep = ev.FinalStatePrimaryLepton();
-    genie::GHepParticle *ISLep = ev.Probe();
-    TLorentzVector FSLepP4 = *FSLep->P4();
-    TLorentzVector ISLepP4 = *ISLep->P4();
-    TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
-
-    int Pdgnu = ISLep->Pdg();
-
-    NEUTMode = 0;
-    if (ev.Summary()->ProcInfo().IsMEC() &&
-        ev.Summary()->ProcInfo().IsWeakCC()) {
-      NEUTMode = (Pdgnu > 0) ? 2 : -2;
-    } else {
-      NEUTMode = genie::utils::ghep::NeutReactionCode(&ev);
-    }
-
-    Enu = ISLepP4.E();
-    Q2 = -emTransfer.Mag2();
-
-    W = ev.Summary()->Kine().W(true);
+    NEUTMode = kin.NEUTMode();
+    Enu = kin.Enu_GeV;
+    Q2 = kin.Q2_GeV2;
+    W = kin.W_GeV;
 
     valid_tree->Fill();
   }
-
-  return resp;
 }
+std::unique_ptr<IGENIESystProvider_tool> MiscInteractionSysts::Clone() const {
+  return std::make_unique<MiscInteractionSysts>(*this);
+}
+
 std::string MiscInteractionSysts::AsString() { return "MiscInteractionSysts"; }
 
 void MiscInteractionSysts::InitValidTree() {
@@ -3,6 +3,8 @@
 
 #include "nusystematics/interface/IGENIESystProvider_tool.hh"
 
+#include "nusystematics/utility/InstanceLocal.hh"
+
 #include "TFile.h"
 #include "TTree.h"
 
@@ -21,6 +23,14 @@ public:
                                             systtools::paramId_t);
 
   systtools::event_unit_response_t GetEventResponse(genie::EventRecord const &);
+  systtools::event_unit_response_t
+  GetEventResponse(genie::EventRecord const &,
+                   nusyst::EventKinematics const &);
+  void FillEventResponse(genie::EventRecord const &,
+                         nusyst::EventKinematics const &,
+                         nusyst::ResponseBuffer &);
+
+  std::unique_ptr<nusyst::IGENIESystProvider_tool> Clone() const;
 
   std::string AsString();
 
@@ -35,24 +45,27 @@ private:
   size_t pidx_nuenumu_xsec_ratio;
   size_t pidx_SPPLowQ2Suppression;
 
-  std::vector<double>
-  GetWeights_C12ToAr40_2p2hScaling(genie::EventRecord const &,
-                                   std::vector<double> const &);
-  std::vector<double>
-  GetWeights_nuenuebar_xsec_ratio(genie::EventRecord const &,
-                                  std::vector<double> const &);
-  std::vector<double>
-  GetWeights_nuenumu_xsec_ratio(genie::EventRecord const &,
-                                std::vector<double> const &);
-  std::vector<double>
-  GetWeights_SPPLowQ2Suppression(genie::EventRecord const &,
-                                 std::vector<double> const &);
+  /// Each writes one weight per value in vals to out.
+  void FillWeights_C12ToAr40_2p2hScaling(genie::EventRecord const &,
+                                         nusyst::EventKinematics const &,
+                                         std::vector<double> const &,
+                                         double *out);
+  void FillWeights_nuenuebar_xsec_ratio(nusyst::EventKinematics const &,
+                                        std::vector<double> const &,
+                                        double *out);
+  void FillWeights_nuenumu_xsec_ratio(nusyst::EventKinematics const &,
+                                      std::vector<double> const &,
+                                      double *out);
+  void FillWeights_SPPLowQ2Suppression(nusyst::EventKinematics const &,
+                                       std::vector<double> const &,
+                                       double *out);
 
   void InitValidTree();
 
-  bool fill_valid_tree;
-  TFile *valid_file;
-  TTree *valid_tree;
+  // The validation tree and its branch addresses belong to this instance.
+  nusyst::InstanceLocal<bool> fill_valid_tree;
+  nusyst::InstanceLocal<TFile *> valid_file;
+  nusyst::InstanceLocal<TTree *> valid_tree;
 
   int NEUTMode;
   double Enu, Q2, W;
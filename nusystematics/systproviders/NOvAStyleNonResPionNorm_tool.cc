@@ -96,21 +96,33 @@ bool NOvAStyleNonResPionNorm::SetupResponseCalculator(
 
 systtools::event_unit_response_t
 NOvAStyleNonResPionNorm::GetEventResponse(genie::EventRecord const &ev) {
+  return GetEventResponse(ev, EventKinematics(ev));
+}
+
+systtools::event_unit_response_t
+NOvAStyleNonResPionNorm::GetEventResponse(genie::EventRecord const &ev,
+                                          EventKinematics const &kin) {
+  return GetEventResponseFromFill(ev, kin);
+}
 
-  systtools::event_unit_response_t resp = this->GetDefaultEventResponse();
+void NOvAStyleNonResPionNorm::FillEventResponse(genie::EventRecord const &,
+                                                EventKinematics const &kin,
+                                                ResponseBuffer &buf) {
 
-  if (!ev.Summary()->ProcInfo().IsDeepInelastic()) {
-    return resp;
+  FillDefaultEventResponse(buf);
+
+  if (kin.mode != simb_mode_copy::kDIS) {
+    return;
   }
-  double WTrue = ev.Summary()->Kine().W(true);
+  double WTrue = kin.W_GeV;
   if (WTrue < WBegin) {
-    return resp;
+    return;
   }
 
-  NRPiChan_t chan = GetNRPiChannel(ev);
+  NRPiChan_t chan = kin.NRPiChannel();
 
   if (!chan) {
-    return resp;
+    return;
   }
 
   double OneSigResp = OneSigmaResponse;
@@ -124,44 +136,27 @@ NOvAStyleNonResPionNorm::GetEventResponse(genie::EventRecord const &ev) {
 
   NRPiChan_t param_channel;
   systtools::SystParamHeader const *hdr = nullptr;
-  size_t smdInx(-1);
   for (channel_param const &chpar : ChannelParameterMapping) {
     if (ChannelsAreEquivalent(chpar.channel, chan, 3)) {
       hdr = &GetSystMetaData()[chpar.paramidx];
       param_channel = chpar.channel;
-      smdInx = chpar.paramidx;
       break;
     }
   }
 
   if (!hdr) {
-    return resp;
+    return;
   }
 
-  resp[smdInx].responses.clear();
-  for (double vals : hdr->paramVariations) {
-    resp[smdInx].responses.push_back( std::max(0., 1 + vals * OneSigResp) );
+  double *out = buf.Fill(hdr->systParamId);
+  for (size_t v_it = 0; v_it < hdr->paramVariations.size(); ++v_it) {
+    out[v_it] = std::max(0., 1 + hdr->paramVariations[v_it] * OneSigResp);
   }
 
   if (fill_valid_tree) {
-    genie::GHepParticle *FSLep = ev.FinalStatePrimaryLepton();
-    genie::GHepParticle *ISLep = ev.Probe();
-    TLorentzVector FSLepP4 = *FSLep->P4();
-    TLorentzVector ISLepP4 = *ISLep->P4();
-    TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
-
-    int Pdgnu = ISLep->Pdg();
-
-    NEUTMode = 0;
-    if (ev.Summary()->ProcInfo().IsMEC() &&
-        ev.Summary()->ProcInfo().IsWeakCC()) {
-      NEUTMode = (Pdgnu > 0) ? 2 : -2;
-    } else {
-      NEUTMode = genie::utils::ghep::NeutReactionCode(&ev);
-    }
-
-    Enu = ISLepP4.E();
-    Q2 = -emTransfer.Mag2();
+    NEUTMode = kin.NEUTMode();
+    Enu = kin.Enu_GeV;
+    Q2 = kin.Q2_GeV2;
     W = WTrue;
 
     NRPiChannel = chan;
@@ -174,9 +169,22 @@ NOvAStyleNonResPionNorm::GetEventResponse(genie::EventRecord const &ev) {
     }
     valid_tree->Fill();
   }
+}
+
+InteractionMask NOvAStyleNonResPionNorm::GetApplicability() {
+  return InteractionMask().Add(simb_mode_copy::kDIS);
+}
 
-  return resp;
+systtools::event_unit_response_t
+NOvAStyleNonResPionNorm::GetUnmatchedEventResponse() {
+  return GetDefaultEventResponse();
 }
+
+std::unique_ptr<IGENIESystProvider_tool>
+NOvAStyleNonResPionNorm::Clone() const {
+  return std::make_unique<NOvAStyleNonResPionNorm>(*this);
+}
+
 std::string NOvAStyleNonResPionNorm::AsString() {
   return "NOvAStyleNonResPionNorm";
 }
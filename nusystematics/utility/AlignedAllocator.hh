@@ -0,0 +1,47 @@
+#ifndef nusystematics_UTILITY_ALIGNEDALLOCATOR_SEEN
+#define nusystematics_UTILITY_ALIGNEDALLOCATOR_SEEN
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace nusyst {
+
+/// Allocator for containers whose storage must start on an Alignment-byte
+/// boundary, e.g. a cache line.
+template <typename T, size_t Alignment = 64> struct AlignedAllocator {
+  typedef T value_type;
+
+  template <typename U> struct rebind {
+    typedef AlignedAllocator<U, Alignment> other;
+  };
+
+  AlignedAllocator() {}
+  template <typename U>
+  AlignedAllocator(AlignedAllocator<U, Alignment> const &) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+  void deallocate(T *p, size_t) {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(AlignedAllocator<U, Alignment> const &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(AlignedAllocator<U, Alignment> const &) const {
+    return false;
+  }
+};
+
+/// Contiguous storage starting on a cache line.
+template <typename T>
+using cache_aligned_vector = std::vector<T, AlignedAllocator<T, 64>>;
+
+} // namespace nusyst
+
+#endif
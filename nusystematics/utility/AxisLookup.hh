@@ -0,0 +1,87 @@
+#ifndef nusystematics_UTILITY_AXISLOOKUP_SEEN
+#define nusystematics_UTILITY_AXISLOOKUP_SEEN
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace nusyst {
+
+/// Finds bins along one histogram axis, numbered as TAxis::FindFixBin does:
+/// 0 for underflow, 1 to NBins in range and NBins + 1 for overflow.
+///
+/// Uniform axes use the same arithmetic as TAxis, variable axes a branch-free
+/// binary search over their edges.
+class AxisLookup {
+  size_t NBins;
+  double Low;
+  double High;
+  bool IsUniform;
+  std::vector<double> Edges;
+
+public:
+  /// How FindBin treats values outside of the axis range.
+  enum class FlowPolicy {
+    /// Return the flow bin, as FindFixBin
+    kKeep,
+    /// Hold values at the closest in-range bin
+    kClamp,
+    /// Return kOutsideRange
+    kOutsideRange
+  };
+  constexpr static int kOutsideRange = -1;
+
+  AxisLookup() : NBins(0), Low(0), High(0), IsUniform(true) {}
+  AxisLookup(size_t nbins, double low, double high)
+      : NBins(nbins), Low(low), High(high), IsUniform(true) {}
+  /// edges must be in ascending order.
+  explicit AxisLookup(std::vector<double> edges)
+      : NBins(edges.size() ? (edges.size() - 1) : 0),
+        Low(edges.size() ? edges.front() : 0),
+        High(edges.size() ? edges.back() : 0), IsUniform(false),
+        Edges(std::move(edges)) {}
+
+  size_t GetNBins() const { return NBins; }
+  double GetLow() const { return Low; }
+  double GetHigh() const { return High; }
+  bool HasUniformBins() const { return IsUniform; }
+  /// Empty for uniform axes.
+  std::vector<double> const &GetEdges() const { return Edges; }
+  bool IsFlowBin(int bin) const { return (bin < 1) || (bin > int(NBins)); }
+
+  int FindFixBin(double x) const {
+    if (x < Low) {
+      return 0;
+    }
+    if (!(x < High)) { // Including NaN
+      return int(NBins) + 1;
+    }
+    if (IsUniform) {
+      return 1 + int(NBins * (x - Low) / (High - Low));
+    }
+    // Last edge <= x, Edges.front() <= x < Edges.back() is known.
+    double const *base = Edges.data();
+    size_t len = Edges.size();
+    while (len > 1) {
+      size_t half = len / 2;
+      base = (base[half] <= x) ? (base + half) : base;
+      len -= half;
+    }
+    return int(base - Edges.data()) + 1;
+  }
+
+  int FindBin(double x, FlowPolicy policy) const {
+    int bin = FindFixBin(x);
+    if ((policy == FlowPolicy::kKeep) || !IsFlowBin(bin)) {
+      return bin;
+    }
+    if (policy == FlowPolicy::kOutsideRange) {
+      return kOutsideRange;
+    }
+    return bin ? int(NBins) : 1;
+  }
+};
+
+} // namespace nusyst
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef nusystematics_UTILITY_BOUNDEDSPSCQUEUE_SEEN
+#define nusystematics_UTILITY_BOUNDEDSPSCQUEUE_SEEN
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace nusyst {
+
+/// Fixed capacity, lock-free queue between exactly one producer thread and
+/// one consumer thread.
+///
+/// Push blocks while the queue is full, which throttles a producer that runs
+/// ahead of its consumer. Either side may Close the queue: the producer to
+/// signal the end of the stream, the consumer to abandon it, after which Push
+/// fails and Pop drains what is left.
+template <typename T> class BoundedSPSCQueue {
+  std::vector<T> ring;
+
+  // Monotonic counts of pushed and popped elements, kept on separate cache
+  // lines as each is written by only one side.
+  alignas(64) std::atomic<size_t> tail;
+  alignas(64) std::atomic<size_t> head;
+  alignas(64) std::atomic<bool> closed;
+
+  /// Spins briefly before sleeping so that a stalled stage does not occupy a
+  /// core.
+  static void Backoff(size_t &attempt) {
+    if (attempt++ < 64) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+
+public:
+  explicit BoundedSPSCQueue(size_t capacity)
+      : ring(capacity ? capacity : 1), tail(0), head(0), closed(false) {}
+
+  BoundedSPSCQueue(BoundedSPSCQueue const &) = delete;
+  BoundedSPSCQueue &operator=(BoundedSPSCQueue const &) = delete;
+
+  size_t Capacity() const { return ring.size(); }
+
+  /// Producer side, returns false if the queue is full.
+  bool TryPush(T &v) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if ((t - head.load(std::memory_order_acquire)) == ring.size()) {
+      return false;
+    }
+    ring[t % ring.size()] = std::move(v);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Producer side, blocks until there is space. Returns false, without
+  /// consuming v, if the queue has been closed.
+  bool Push(T v) {
+    size_t attempt = 0;
+    while (!closed.load(std::memory_order_acquire)) {
+      if (TryPush(v)) {
+        return true;
+      }
+      Backoff(attempt);
+    }
+    return false;
+  }
+
+  /// Consumer side, returns false if the queue is empty.
+  bool TryPop(T &v) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    v = std::move(ring[h % ring.size()]);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer side, blocks until an element is available. Returns false once
+  /// the queue is closed and empty.
+  bool Pop(T &v) {
+    size_t attempt = 0;
+    while (true) {
+      if (TryPop(v)) {
+        return true;
+      }
+      if (closed.load(std::memory_order_acquire)) {
+        // An element may have been pushed between the TryPop and the close.
+        return TryPop(v);
+      }
+      Backoff(attempt);
+    }
+  }
+
+  void Close() { closed.store(true, std::memory_order_release); }
+  bool IsClosed() const { return closed.load(std::memory_order_acquire); }
+};
+
+} // namespace nusyst
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef nusystematics_UTILITY_EVENTKINEMATICS_SEEN
+#define nusystematics_UTILITY_EVENTKINEMATICS_SEEN
+
+#include "nusystematics/utility/GENIEUtils.hh"
+#include "nusystematics/utility/exceptions.hh"
+#include "nusystematics/utility/simbUtility.hh"
+
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/GHEP/GHepParticle.h"
+#include "Framework/GHEP/GHepUtils.h"
+#include "Framework/Interaction/SppChannel.h"
+
+#include "TLorentzVector.h"
+
+namespace nusyst {
+
+/// Digest of the GHep record quantities that are used by more than one
+/// systematic provider.
+///
+/// Built once per event by response_helper and handed to each provider so that
+/// the four-vector algebra and record scans are not repeated per provider.
+///
+/// The lepton and ProcInfo quantities are filled on construction. The NEUT
+/// code, hit-nucleon frame, QE-like target and particle record scan are each
+/// computed on first access and then cached, so an event only pays for those
+/// that an applicable provider asks for. The record must therefore outlive
+/// the digest, and the first access to a lazy quantity is not thread safe.
+struct EventKinematics {
+  int nu_pdg;
+  int fslep_pdg;
+  bool is_cc;
+  bool is_charm;
+  simb_mode_copy mode;
+
+  /// Lab frame lepton four momenta
+  TLorentzVector ISLepP4, FSLepP4;
+
+  double Enu_GeV;
+  double q0_GeV, q3_GeV, Q2_GeV2;
+  /// Kine().W(true)
+  double W_GeV;
+
+  explicit EventKinematics(genie::EventRecord const &ev) : fEv(&ev) {
+    genie::GHepParticle *FSLep = ev.FinalStatePrimaryLepton();
+    genie::GHepParticle *ISLep = ev.Probe();
+
+    if (!FSLep || !ISLep) {
+      throw incorrectly_generated()
+          << "[ERROR]: Failed to find IS and FS lepton in event: "
+          << ev.Summary()->AsString();
+    }
+
+    genie::ProcessInfo const &proc = ev.Summary()->ProcInfo();
+
+    nu_pdg = ISLep->Pdg();
+    fslep_pdg = FSLep->Pdg();
+    is_cc = proc.IsWeakCC();
+    is_charm = ev.Summary()->ExclTag().IsCharmEvent();
+    mode = GetSimbMode(ev);
+
+    ISLepP4 = *ISLep->P4();
+    FSLepP4 = *FSLep->P4();
+    TLorentzVector emTransfer = (ISLepP4 - FSLepP4);
+
+    Enu_GeV = ISLepP4.E();
+    q0_GeV = emTransfer.E();
+    q3_GeV = emTransfer.Vect().Mag();
+    Q2_GeV2 = -emTransfer.Mag2();
+    W_GeV = ev.Summary()->Kine().W(true);
+  }
+
+  /// NEUT reaction code, CC MEC events are given +/-2
+  int NEUTMode() const {
+    CacheNEUTCode();
+    return fNEUTMode;
+  }
+  genie::SppChannel_t SPPChannel() const {
+    CacheNEUTCode();
+    return fSPPChannel;
+  }
+
+  bool HitNucIsSet() const {
+    CacheHitNucFrame();
+    return fHitNucIsSet;
+  }
+  /// Zero unless HitNucIsSet
+  double Enu_nuc_rest_frame_GeV() const {
+    CacheHitNucFrame();
+    return fEnu_nuc_rest_frame_GeV;
+  }
+  double q0_nuc_rest_frame_GeV() const {
+    CacheHitNucFrame();
+    return fq0_nuc_rest_frame_GeV;
+  }
+  double q3_nuc_rest_frame_GeV() const {
+    CacheHitNucFrame();
+    return fq3_nuc_rest_frame_GeV;
+  }
+  double Q2_nuc_rest_frame_GeV2() const {
+    CacheHitNucFrame();
+    return fQ2_nuc_rest_frame_GeV2;
+  }
+
+  QELikeTarget_t QELTarget() const {
+    CacheQELTarget();
+    return fQELTarget;
+  }
+  /// Set if the record is MEC but the 2p2h nucleon pair could not be
+  /// determined, users of QELTarget should call GetQELikeTarget to report the
+  /// error.
+  bool QELTargetIndeterminable() const {
+    CacheQELTarget();
+    return fQELTargetIndeterminable;
+  }
+
+  /// Single pass over the particle record, shared by the quantities below
+  GHepParticleSummary const &Particles() const {
+    CacheParticles();
+    return fParticles;
+  }
+  NRPiChan_t NRPiChannel() const {
+    CacheParticles();
+    return fNRPiChannel;
+  }
+  /// As calculated by GetErecoil_MINERvA_LowRecoil
+  double EAvail_GeV() const {
+    CacheParticles();
+    return fParticles.Erecoil_MINERvA_GeV;
+  }
+
+private:
+  genie::EventRecord const *fEv;
+
+  mutable bool fHaveNEUTCode = false;
+  mutable int fNEUTMode;
+  mutable genie::SppChannel_t fSPPChannel;
+
+  mutable bool fHaveHitNucFrame = false;
+  mutable bool fHitNucIsSet;
+  mutable double fEnu_nuc_rest_frame_GeV, fq0_nuc_rest_frame_GeV,
+      fq3_nuc_rest_frame_GeV, fQ2_nuc_rest_frame_GeV2;
+
+  mutable bool fHaveQELTarget = false;
+  mutable QELikeTarget_t fQELTarget;
+  mutable bool fQELTargetIndeterminable;
+
+  mutable bool fHaveParticles = false;
+  mutable GHepParticleSummary fParticles;
+  mutable NRPiChan_t fNRPiChannel;
+
+  void CacheNEUTCode() const {
+    if (fHaveNEUTCode) {
+      return;
+    }
+    int NEUTCode = genie::utils::ghep::NeutReactionCode(fEv);
+    fNEUTMode = (fEv->Summary()->ProcInfo().IsMEC() && is_cc)
+                    ? ((nu_pdg > 0) ? 2 : -2)
+                    : NEUTCode;
+    fSPPChannel = SPPChannelFromNEUTCode(NEUTCode);
+    fHaveNEUTCode = true;
+  }
+
+  void CacheHitNucFrame() const {
+    if (fHaveHitNucFrame) {
+      return;
+    }
+    genie::Target const &tgt = fEv->Summary()->InitState().Tgt();
+    fHitNucIsSet = tgt.HitNucIsSet();
+    fEnu_nuc_rest_frame_GeV = 0;
+    fq0_nuc_rest_frame_GeV = 0;
+    fq3_nuc_rest_frame_GeV = 0;
+    fQ2_nuc_rest_frame_GeV2 = 0;
+    if (fHitNucIsSet) {
+      TLorentzVector NucP4 = tgt.HitNucP4();
+      TLorentzVector ISLepP4_nuc = ISLepP4;
+      TLorentzVector FSLepP4_nuc = FSLepP4;
+      ISLepP4_nuc.Boost(-NucP4.BoostVector());
+      FSLepP4_nuc.Boost(-NucP4.BoostVector());
+      TLorentzVector emTransfer_nuc = (ISLepP4_nuc - FSLepP4_nuc);
+
+      fEnu_nuc_rest_frame_GeV = ISLepP4_nuc.E();
+      fq0_nuc_rest_frame_GeV = emTransfer_nuc.E();
+      fq3_nuc_rest_frame_GeV = emTransfer_nuc.Vect().Mag();
+      fQ2_nuc_rest_frame_GeV2 = -emTransfer_nuc.Mag2();
+    }
+    fHaveHitNucFrame = true;
+  }
+
+  void CacheQELTarget() const {
+    if (fHaveQELTarget) {
+      return;
+    }
+    fQELTargetIndeterminable = false;
+    try {
+      fQELTarget = GetQELikeTarget(*fEv);
+    } catch (indeterminable_QELikeTarget const &) {
+      fQELTarget = QELikeTarget_t::kInvalidTopology;
+      fQELTargetIndeterminable = true;
+    }
+    fHaveQELTarget = true;
+  }
+
+  void CacheParticles() const {
+    if (fHaveParticles) {
+      return;
+    }
+    fParticles = SummarizeGHepParticles(*fEv);
+    fNRPiChannel = GetNRPiChannel(*fEv, fParticles);
+    fHaveParticles = true;
+  }
+};
+
+} // namespace nusyst
+
+#endif
@@ -15,13 +15,8 @@
 #include <sstream>
 
 namespace nusyst {
-/// Gets the GENIE SPP channel enum for a supplied GHepEvent
-///
-/// N.B. going via NEUT mode as genie::SppChannel::FromInteraction doesn't work
-/// for RES events.
-inline genie::SppChannel_t SPPChannelFromGHep(genie::EventRecord const &ev) {
-  int NEUTCh = genie::utils::ghep::NeutReactionCode(&ev);
-
+/// Gets the GENIE SPP channel enum for a NEUT reaction code
+inline genie::SppChannel_t SPPChannelFromNEUTCode(int NEUTCh) {
   switch (NEUTCh) {
   case 11: { // kCCSPP_PPip
     return genie::kSpp_vp_cc_10100;
@@ -45,6 +40,14 @@ inline genie::SppChannel_t SPPChannelFromGHep(genie::EventRecord const &ev) {
   }
 }
 
+/// Gets the GENIE SPP channel enum for a supplied GHepEvent
+///
+/// N.B. going via NEUT mode as genie::SppChannel::FromInteraction doesn't work
+/// for RES events.
+inline genie::SppChannel_t SPPChannelFromGHep(genie::EventRecord const &ev) {
+  return SPPChannelFromNEUTCode(genie::utils::ghep::NeutReactionCode(&ev));
+}
+
 enum class QELikeTarget_t { kNN = 0, knp, kQE, kInvalidTopology };
 NEW_SYSTTOOLS_EXCEPT(indeterminable_QELikeTarget);
 
@@ -107,7 +110,17 @@ inline NRPiChan_t BuildNRPiChannel(bool IsNeutrino, bool IsCC,
          NPiplus * 10000 + NPiminus * 100000 + NPi0 * 1000000;
 }
 
-inline NRPiChan_t GetNRPiChannel(genie::EventRecord const &ev) {
+/// Whether a GHep particle enters the pion counting used to build NEUT
+/// reaction codes and non-resonant pion channels.
+struct GHepHadronCounting {
+  bool decayed;
+  bool parent_included;
+  bool count_it;
+};
+
+inline GHepHadronCounting
+GetGHepHadronCounting(genie::EventRecord const &ev,
+                      genie::GHepParticle const &p, bool nuclear_target) {
 // This code in this method is adapted from the GENIE source code found in GHep/GHepUtils.cxx
 // This method therefore carries the GENIE licence as copied below:
 //
@@ -115,6 +128,128 @@ inline NRPiChan_t GetNRPiChannel(genie::EventRecord const &ev) {
 /// For the full text of the license visit http://copyright.genie-mc.org
 /// or see $GENIE/LICENSE
 //
+  genie::GHepStatus_t ghep_ist = (genie::GHepStatus_t)p.Status();
+  int ghep_pdgc = p.Pdg();
+  int ghep_fm = p.FirstMother();
+  int ghep_fmpdgc = (ghep_fm == -1) ? 0 : ev.Particle(ghep_fm)->Pdg();
+
+  // For nuclear targets use hadrons marked as 'hadron in the nucleus'
+  // which are the ones passed in the intranuclear rescattering
+  // For free nucleon targets use particles marked as 'final state'
+  // but make an exception for decayed pi0's,eta's (count them and not their
+  // daughters)
+
+  GHepHadronCounting hc;
+  hc.decayed = (ghep_ist == genie::kIStDecayedState &&
+                (ghep_pdgc == genie::kPdgPi0 || ghep_pdgc == genie::kPdgEta));
+  hc.parent_included =
+      (ghep_fmpdgc == genie::kPdgPi0 || ghep_fmpdgc == genie::kPdgEta);
+
+  hc.count_it =
+      (nuclear_target && ghep_ist == genie::kIStHadronInTheNucleus) ||
+      (!nuclear_target && hc.decayed) ||
+      (!nuclear_target && ghep_ist == genie::kIStStableFinalState &&
+       !hc.parent_included);
+  return hc;
+}
+
+/// Quantities accumulated over the GHep particle record, filled by a single
+/// pass in SummarizeGHepParticles.
+struct GHepParticleSummary {
+  /// Pions counted with GetGHepHadronCounting
+  size_t NPip, NPim, NPi0;
+
+  /// As calculated by GetErecoil_MINERvA_LowRecoil
+  double Erecoil_MINERvA_GeV;
+
+  /// Highest momentum stable final state pi+ or pi0, pdg is 0 if there is none
+  int LeadingPi_pdg;
+  double LeadingPi_p_GeV;
+  double LeadingPi_CosTheta;
+
+  /// Hadrons handed to the intranuclear cascade, i.e. with status
+  /// kIStHadronInTheNucleus
+  size_t NHadronInNucleus, NPiInNucleus, NNucleonInNucleus;
+};
+
+inline GHepParticleSummary
+SummarizeGHepParticles(genie::EventRecord const &ev) {
+  GHepParticleSummary summ{0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+  bool nuclear_target = ev.Summary()->InitState().Tgt().IsNucleus();
+
+  int NParts = ev.GetEntries();
+  for (int p_it = 0; p_it < NParts; ++p_it) {
+    genie::GHepParticle const &p = *ev.Particle(p_it);
+    int pdg = p.Pdg();
+    bool is_stable_fs = (p.Status() == genie::kIStStableFinalState);
+
+    if (is_stable_fs) {
+      switch (pdg) {
+      case 2212:
+      case 211:
+      case -211: {
+        summ.Erecoil_MINERvA_GeV += p.KinE();
+        break;
+      }
+      case 111:
+      case 11:
+      case -11:
+      case -22: {
+        summ.Erecoil_MINERvA_GeV += p.E();
+        break;
+      }
+      default: {}
+      }
+
+      if ((pdg == 211) || (pdg == 111)) {
+        double mom = p.P4()->Vect().Mag();
+        if (summ.LeadingPi_p_GeV < mom) {
+          summ.LeadingPi_pdg = pdg;
+          summ.LeadingPi_p_GeV = mom;
+          summ.LeadingPi_CosTheta = p.P4()->Vect().CosTheta();
+        }
+      }
+    }
+
+    if (p.Status() == genie::kIStHadronInTheNucleus) {
+      summ.NHadronInNucleus++;
+      if ((pdg == genie::kPdgPiP) || (pdg == genie::kPdgPiM) ||
+          (pdg == genie::kPdgPi0)) {
+        summ.NPiInNucleus++;
+      } else if ((pdg == genie::kPdgProton) || (pdg == genie::kPdgNeutron)) {
+        summ.NNucleonInNucleus++;
+      }
+    }
+
+    if ((pdg != genie::kPdgPiP) && (pdg != genie::kPdgPiM) &&
+        (pdg != genie::kPdgPi0)) {
+      continue;
+    }
+    if (!GetGHepHadronCounting(ev, p, nuclear_target).count_it) {
+      continue;
+    }
+    if (pdg == genie::kPdgPiP) {
+      summ.NPip++;
+    } else if (pdg == genie::kPdgPiM) {
+      summ.NPim++;
+    } else {
+      summ.NPi0++;
+    }
+  }
+
+  // For nue CC scattering, we would have counted the E of the charged lepton,
+  // subtract it off here
+  if (ev.Summary()->ProcInfo().IsWeakCC() && (abs(ev.Probe()->Pdg()) == 12)) {
+    summ.Erecoil_MINERvA_GeV -= ev.FinalStatePrimaryLepton()->P4()->E();
+  }
+
+  return summ;
+}
+
+/// Uses the pion counts from a previously built summary of ev.
+inline NRPiChan_t GetNRPiChannel(genie::EventRecord const &ev,
+                                 GHepParticleSummary const &summ) {
   if (!ev.Summary()->ProcInfo().IsDeepInelastic()) {
     return 0;
   }
@@ -134,52 +269,18 @@ inline NRPiChan_t GetNRPiChannel(genie::EventRecord const &ev) {
         << "[ERROR]: Failed to find IS and FS lepton in event: "
         << ev.Summary()->AsString();
   }
-  int NPi0 = 0, NPip = 0, NPim = 0;
-
-  bool nuclear_target = tgt.IsNucleus();
-
-  TIter event_iter(&ev);
-  genie::GHepParticle *p = 0;
-
-  while ((p = dynamic_cast<genie::GHepParticle *>(event_iter.Next()))) {
-    genie::GHepStatus_t ghep_ist = (genie::GHepStatus_t)p->Status();
-    int ghep_pdgc = p->Pdg();
-    int ghep_fm = p->FirstMother();
-    int ghep_fmpdgc = (ghep_fm == -1) ? 0 : ev.Particle(ghep_fm)->Pdg();
-
-    // For nuclear targets use hadrons marked as 'hadron in the nucleus'
-    // which are the ones passed in the intranuclear rescattering
-    // For free nucleon targets use particles marked as 'final state'
-    // but make an exception for decayed pi0's,eta's (count them and not their
-    // daughters)
-
-    bool decayed =
-        (ghep_ist == genie::kIStDecayedState &&
-         (ghep_pdgc == genie::kPdgPi0 || ghep_pdgc == genie::kPdgEta));
-    bool parent_included =
-        (ghep_fmpdgc == genie::kPdgPi0 || ghep_fmpdgc == genie::kPdgEta);
-
-    bool count_it =
-        (nuclear_target && ghep_ist == genie::kIStHadronInTheNucleus) ||
-        (!nuclear_target && decayed) ||
-        (!nuclear_target && ghep_ist == genie::kIStStableFinalState &&
-         !parent_included);
-
-    if (!count_it) {
-      continue;
-    }
-    if (ghep_pdgc == genie::kPdgPiP) {
-      NPip++;
-    } else if (ghep_pdgc == genie::kPdgPiM) {
-      NPim++;
-    } else if (ghep_pdgc == genie::kPdgPi0) {
-      NPi0++;
-    }
-  }
 
   return BuildNRPiChannel(ISLep->Pdg() > 0, ev.Summary()->ProcInfo().IsWeakCC(),
                           (tgt.HitNucPdg() == genie::kPdgProton) ? 2 : 1,
-                          NPi0 + NPip + NPim, NPip, NPim, NPi0);
+                          summ.NPi0 + summ.NPip + summ.NPim, summ.NPip,
+                          summ.NPim, summ.NPi0);
+}
+
+inline NRPiChan_t GetNRPiChannel(genie::EventRecord const &ev) {
+  if (!ev.Summary()->ProcInfo().IsDeepInelastic()) {
+    return 0;
+  }
+  return GetNRPiChannel(ev, SummarizeGHepParticles(ev));
 }
 
 inline std::string GetNRPiChannelName(NRPiChan_t ch) {
@@ -218,41 +319,7 @@ inline bool ChannelsAreEquivalent(NRPiChan_t ch, NRPiChan_t event_ch,
 }
 
 inline double GetErecoil_MINERvA_LowRecoil(genie::EventRecord const &ev) {
-  // Get total energy of hadronic system.
-  double Erecoil = 0.0;
-
-  TIter event_iter(&ev);
-  genie::GHepParticle *p = 0;
-
-  while ((p = dynamic_cast<genie::GHepParticle *>(event_iter.Next()))) {
-    if (p->Status() != genie::kIStStableFinalState) {
-      continue;
-    }
-    switch (p->Pdg()) {
-    case 2212:
-    case 211:
-    case -211: {
-      Erecoil += p->KinE();
-      break;
-    }
-    case 111:
-    case 11:
-    case -11:
-    case -22: {
-      Erecoil += p->E();
-      break;
-    }
-    default: {}
-    }
-  }
-
-  // For nue CC scattering, we would have counted the E of the charged lepton,
-  // subtract it off here
-  if (ev.Summary()->ProcInfo().IsWeakCC() && (abs(ev.Probe()->Pdg()) == 12)) {
-    Erecoil -= ev.FinalStatePrimaryLepton()->P4()->E();
-  }
-
-  return Erecoil;
+  return SummarizeGHepParticles(ev).Erecoil_MINERvA_GeV;
 }
 
 inline simb_mode_copy GetSimbMode(genie::EventRecord const &ev) {
@@ -300,31 +367,14 @@ inline std::string DumpGENIEEv(genie::EventRecord const &ev) {
 
   bool nuclear_target = tgt.IsNucleus();
 
-  TIter event_iter(&ev);
-  genie::GHepParticle *p = 0;
-  size_t p_it = 0;
-
-  while ((p = dynamic_cast<genie::GHepParticle *>(event_iter.Next()))) {
-    genie::GHepStatus_t ghep_ist = (genie::GHepStatus_t)p->Status();
-    int ghep_pdgc = p->Pdg();
-    int ghep_fm = p->FirstMother();
-    int ghep_fmpdgc = (ghep_fm == -1) ? 0 : ev.Particle(ghep_fm)->Pdg();
-
-    bool decayed =
-        (ghep_ist == genie::kIStDecayedState &&
-         (ghep_pdgc == genie::kPdgPi0 || ghep_pdgc == genie::kPdgEta));
-    bool parent_included =
-        (ghep_fmpdgc == genie::kPdgPi0 || ghep_fmpdgc == genie::kPdgEta);
-
-    bool count_it =
-        (nuclear_target && ghep_ist == genie::kIStHadronInTheNucleus) ||
-        (!nuclear_target && decayed) ||
-        (!nuclear_target && ghep_ist == genie::kIStStableFinalState &&
-         !parent_included);
-
-    ss << "Part: " << p_it++ << ", pdg = " << ghep_pdgc << ", decayed ? "
-       << decayed << ", parent_included ? " << parent_included
-       << ", counting ? " << count_it << std::endl;
+  int NParts = ev.GetEntries();
+  for (int p_it = 0; p_it < NParts; ++p_it) {
+    genie::GHepParticle const &p = *ev.Particle(p_it);
+    GHepHadronCounting hc = GetGHepHadronCounting(ev, p, nuclear_target);
+
+    ss << "Part: " << p_it << ", pdg = " << p.Pdg() << ", decayed ? "
+       << hc.decayed << ", parent_included ? " << hc.parent_included
+       << ", counting ? " << hc.count_it << std::endl;
   }
   ss << std::endl;
   return ss.str();
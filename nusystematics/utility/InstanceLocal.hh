@@ -0,0 +1,35 @@
+#ifndef nusystematics_UTILITY_INSTANCELOCAL_SEEN
+#define nusystematics_UTILITY_INSTANCELOCAL_SEEN
+
+namespace nusyst {
+
+/// Member value that belongs to the object that set it, copies of the owner
+/// start from a value-initialized T instead.
+///
+/// Used for state such as a validation TTree and the branch addresses bound to
+/// the owner's members, so that a defaulted copy constructor, and so Clone,
+/// never shares it.
+template <typename T> class InstanceLocal {
+  T value;
+
+public:
+  InstanceLocal() : value{} {}
+  InstanceLocal(T v) : value(v) {}
+  InstanceLocal(InstanceLocal const &) : value{} {}
+
+  InstanceLocal &operator=(InstanceLocal const &) {
+    value = T{};
+    return *this;
+  }
+  InstanceLocal &operator=(T v) {
+    value = v;
+    return *this;
+  }
+
+  operator T() const { return value; }
+  T operator->() const { return value; }
+};
+
+} // namespace nusyst
+
+#endif
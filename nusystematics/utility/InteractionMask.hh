@@ -0,0 +1,67 @@
+#ifndef nusystematics_UTILITY_INTERACTIONMASK_SEEN
+#define nusystematics_UTILITY_INTERACTIONMASK_SEEN
+
+#include "nusystematics/utility/EventKinematics.hh"
+#include "nusystematics/utility/enumclass2int.hh"
+#include "nusystematics/utility/simbUtility.hh"
+
+#include <cstdint>
+
+namespace nusyst {
+
+/// Set of interaction mode, CC/NC and neutrino/antineutrino combinations that
+/// a systematic provider can give a non-trivial response to.
+///
+/// One bit per combination, modes kUnknownInteraction to kWeakMix.
+class InteractionMask {
+  uint64_t bits;
+
+  static uint64_t Bit(simb_mode_copy mode, bool is_cc, bool is_nu) {
+    int mode_idx = e2i(mode) + 1;
+    if ((mode_idx < 0) || (mode_idx > (e2i(simb_mode_copy::kWeakMix) + 1))) {
+      return 0;
+    }
+    return uint64_t(1) << (mode_idx * 4 + is_cc * 2 + is_nu);
+  }
+
+public:
+  enum Current { kCC = 1, kNC = 2, kAnyCurrent = kCC | kNC };
+  enum NuType { kNu = 1, kNuBar = 2, kAnyNuType = kNu | kNuBar };
+
+  InteractionMask() : bits(0) {}
+
+  static InteractionMask All() {
+    InteractionMask m;
+    m.bits = ~uint64_t(0);
+    return m;
+  }
+
+  InteractionMask &Add(simb_mode_copy mode, int current = kAnyCurrent,
+                       int nutype = kAnyNuType) {
+    for (bool is_cc : {true, false}) {
+      if (!(current & (is_cc ? kCC : kNC))) {
+        continue;
+      }
+      for (bool is_nu : {true, false}) {
+        if (!(nutype & (is_nu ? kNu : kNuBar))) {
+          continue;
+        }
+        bits |= Bit(mode, is_cc, is_nu);
+      }
+    }
+    return *this;
+  }
+
+  bool IsAll() const { return bits == ~uint64_t(0); }
+
+  bool Matches(simb_mode_copy mode, bool is_cc, bool is_nu) const {
+    return IsAll() || (bits & Bit(mode, is_cc, is_nu));
+  }
+  bool Matches(EventKinematics const &kin) const {
+    return Matches(kin.mode, kin.is_cc, kin.nu_pdg > 0);
+  }
+};
+
+} // namespace nusyst
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef nusystematics_UTILITY_LATENCYSTATS_SEEN
+#define nusystematics_UTILITY_LATENCYSTATS_SEEN
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace nusyst {
+
+/// Accumulates the latencies of repeated calls in constant memory.
+///
+/// Calls are counted in power-of-two buckets of microseconds, so quantiles
+/// are estimated to within a factor of two, which is enough to tell a dial
+/// with a long tail from a uniformly slow one.
+class LatencyStats {
+  // Bucket 0 holds calls faster than 1 us, bucket i those in
+  // [2^(i-1), 2^i) us and the last bucket everything slower.
+  constexpr static size_t NBuckets = 32;
+
+  size_t NCalls;
+  double TotalSeconds;
+  double MaxSeconds;
+  std::array<size_t, NBuckets> buckets;
+
+  static size_t GetBucket(double seconds) {
+    double us = seconds * 1E6;
+    if (!(us >= 1)) {
+      return 0;
+    }
+    return std::min(size_t(std::ilogb(us)) + 1, NBuckets - 1);
+  }
+
+public:
+  LatencyStats() : NCalls(0), TotalSeconds(0), MaxSeconds(0), buckets{} {}
+
+  void Add(double seconds) {
+    NCalls++;
+    TotalSeconds += seconds;
+    MaxSeconds = std::max(MaxSeconds, seconds);
+    buckets[GetBucket(seconds)]++;
+  }
+
+  void Merge(LatencyStats const &other) {
+    NCalls += other.NCalls;
+    TotalSeconds += other.TotalSeconds;
+    MaxSeconds = std::max(MaxSeconds, other.MaxSeconds);
+    for (size_t b_it = 0; b_it < NBuckets; ++b_it) {
+      buckets[b_it] += other.buckets[b_it];
+    }
+  }
+
+  size_t GetNCalls() const { return NCalls; }
+  double GetTotalSeconds() const { return TotalSeconds; }
+  double GetMeanSeconds() const { return NCalls ? (TotalSeconds / NCalls) : 0; }
+  double GetMaxSeconds() const { return MaxSeconds; }
+
+  /// Upper edge of the bucket holding quantile q in [0, 1], capped at the
+  /// slowest call.
+  double GetQuantileSeconds(double q) const {
+    if (!NCalls) {
+      return 0;
+    }
+    double NBelow = std::max(q, 0.0) * double(NCalls);
+    size_t cumulative = 0;
+    for (size_t b_it = 0; b_it < NBuckets; ++b_it) {
+      cumulative += buckets[b_it];
+      if (double(cumulative) >= NBelow) {
+        return std::min(std::ldexp(1E-6, int(b_it)), MaxSeconds);
+      }
+    }
+    return MaxSeconds;
+  }
+};
+
+} // namespace nusyst
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef nusystematics_UTILITY_SCOPEDTH1ADDDIRECTORY_SEEN
+#define nusystematics_UTILITY_SCOPEDTH1ADDDIRECTORY_SEEN
+
+#include "TH1.h"
+
+#include <cstddef>
+#include <mutex>
+
+namespace nusyst {
+
+/// Holds TH1::AddDirectory on while any thread is within a guard, restoring
+/// the previous setting when the last one leaves.
+///
+/// GENIE weight calculators book histograms, which must be owned by the
+/// current directory, when they are built. As TH1::AddDirectory is
+/// process-wide, concurrent guards are counted rather than each saving and
+/// restoring it. The setting is only written if it was off.
+class ScopedTH1AddDirectory {
+  struct State {
+    std::mutex mtx;
+    size_t depth = 0;
+    bool was_set = true;
+  };
+  static State &GetState() {
+    static State state;
+    return state;
+  }
+
+public:
+  ScopedTH1AddDirectory() {
+    State &st = GetState();
+    std::lock_guard<std::mutex> lock(st.mtx);
+    if (!st.depth++) {
+      st.was_set = TH1::AddDirectoryStatus();
+      if (!st.was_set) {
+        TH1::AddDirectory(true);
+      }
+    }
+  }
+  ~ScopedTH1AddDirectory() {
+    State &st = GetState();
+    std::lock_guard<std::mutex> lock(st.mtx);
+    if (!--st.depth && !st.was_set) {
+      TH1::AddDirectory(false);
+    }
+  }
+
+  ScopedTH1AddDirectory(ScopedTH1AddDirectory const &) = delete;
+  ScopedTH1AddDirectory &operator=(ScopedTH1AddDirectory const &) = delete;
+};
+
+} // namespace nusyst
+
+#endif
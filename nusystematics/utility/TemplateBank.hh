@@ -0,0 +1,452 @@
+#ifndef nusystematics_UTILITY_TEMPLATEBANK_SEEN
+#define nusystematics_UTILITY_TEMPLATEBANK_SEEN
+
+#include "nusystematics/utility/AxisLookup.hh"
+
+#include "systematicstools/utility/exceptions.hh"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nusyst {
+
+NEW_SYSTTOOLS_EXCEPT(invalid_template_bank);
+
+/// On-disk layout of a template bank: a single file holding the axes, value
+/// grid and flattened [bin][value] contents of many templates, so that they
+/// can be mapped read-only and shared between processes.
+///
+/// All integers and doubles are in the byte order of the writing machine,
+/// which is checked on reading. Offsets are from the start of the file and
+/// every section starts on an 8 byte boundary, the response tables on a 64
+/// byte boundary.
+///
+///  FileHeader
+///  key strings
+///  DirectoryEntry[NTemplates]
+///  for each template:
+///    TemplateHeader
+///    AxisHeader, followed by NBins + 1 edges for variable axes, per axis
+///    double values[NValues]
+///    double responses[NFlatBins][NValues]
+namespace template_bank {
+
+constexpr char kMagic[8] = {'N', 'U', 'S', 'Y', 'S', 'T', 'T', 'B'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order_mark;
+  uint64_t file_size;
+  /// Checksum of everything after the header.
+  uint64_t checksum;
+  uint64_t NTemplates;
+  uint64_t directory_offset;
+  uint64_t reserved[2];
+};
+static_assert(sizeof(FileHeader) == 64, "Unexpected FileHeader padding.");
+
+struct DirectoryEntry {
+  uint64_t key_offset;
+  uint64_t key_size;
+  uint64_t template_offset;
+  uint64_t template_size;
+};
+
+struct TemplateHeader {
+  uint32_t NDims;
+  uint32_t NValues;
+  uint64_t NFlatBins;
+  uint64_t values_offset;
+  uint64_t responses_offset;
+};
+
+struct AxisHeader {
+  uint32_t IsUniform;
+  uint32_t NBins;
+  double Low;
+  double High;
+};
+
+/// FNV-1a over 64-bit words, size must be a multiple of 8.
+inline uint64_t Checksum(char const *data, size_t size) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t b_it = 0; b_it < size; b_it += 8) {
+    uint64_t word;
+    std::memcpy(&word, data + b_it, 8);
+    hash ^= word;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+} // namespace template_bank
+
+/// A template bank file mapped read-only into memory.
+///
+/// Banks are opened through Open, which maps each file once per process and
+/// shares the mapping between all of the templates loaded from it, the pages
+/// are shared with any other process that maps the same file.
+class TemplateBank {
+public:
+  /// A view of one template, the values and responses point into the
+  /// mapping and live as long as the TemplateBank.
+  struct Template {
+    std::vector<AxisLookup> Axes;
+    size_t NValues;
+    double const *Values;
+    size_t NFlatBins;
+    /// Laid out [bin][value] over every bin, including flow bins.
+    double const *Responses;
+  };
+
+private:
+  std::string path;
+  char const *data;
+  size_t size;
+  std::map<std::string, template_bank::DirectoryEntry> directory;
+
+  template <typename T> T Read(uint64_t offset) const {
+    if ((offset + sizeof(T)) > size) {
+      throw invalid_template_bank()
+          << "[ERROR]: Template bank " << std::quoted(path)
+          << " is truncated, expected " << sizeof(T) << " bytes at offset "
+          << offset << ", but the file is only " << size << " bytes.";
+    }
+    T obj;
+    std::memcpy(&obj, data + offset, sizeof(T));
+    return obj;
+  }
+
+  double const *ReadArray(uint64_t offset, uint64_t n) const {
+    if ((offset % 8) || ((offset + n * sizeof(double)) > size)) {
+      throw invalid_template_bank()
+          << "[ERROR]: Template bank " << std::quoted(path) << " holds an "
+          << n << " element array at offset " << offset
+          << ", which is misaligned or extends past the end of the file.";
+    }
+    return reinterpret_cast<double const *>(data + offset);
+  }
+
+  void Map() {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw invalid_template_bank()
+          << "[ERROR]: Failed to open template bank " << std::quoted(path)
+          << ": " << std::strerror(errno);
+    }
+    struct stat st;
+    if (fstat(fd, &st)) {
+      int err = errno;
+      close(fd);
+      throw invalid_template_bank()
+          << "[ERROR]: Failed to stat template bank " << std::quoted(path)
+          << ": " << std::strerror(err);
+    }
+    size = size_t(st.st_size);
+    if (size < sizeof(template_bank::FileHeader)) {
+      close(fd);
+      throw invalid_template_bank()
+          << "[ERROR]: Template bank " << std::quoted(path) << " is only "
+          << size << " bytes, too small to hold a header.";
+    }
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    int err = errno;
+    // The mapping holds its own reference to the file.
+    close(fd);
+    if (addr == MAP_FAILED) {
+      throw invalid_template_bank()
+          << "[ERROR]: Failed to map template bank " << std::quoted(path)
+          << ": " << std::strerror(err);
+    }
+    data = static_cast<char const *>(addr);
+  }
+
+  void ReadDirectory(bool verify) {
+    template_bank::FileHeader hdr =
+        Read<template_bank::FileHeader>(0);
+    if (std::memcmp(hdr.magic, template_bank::kMagic, 8)) {
+      throw invalid_template_bank()
+          << "[ERROR]: " << std::quoted(path) << " is not a template bank.";
+    }
+    if (hdr.byte_order_mark != template_bank::kByteOrderMark) {
+      throw invalid_template_bank()
+          << "[ERROR]: Template bank " << std::quoted(path)
+          << " was written on a machine of different byte order, please "
+             "regenerate it.";
+    }
+    if (hdr.version != template_bank::kVersion) {
+      throw invalid_template_bank()
+          << "[ERROR]: Template bank " << std::quoted(path)
+          << " has format version " << hdr.version
+          << ", but this build reads version " << template_bank::kVersion
+          << ", please regenerate it.";
+    }
+    if ((hdr.file_size != size) || (size % 8)) {
+      throw invalid_template_bank()
+          << "[ERROR]: Template bank " << std::quoted(path) << " should be "
+          << hdr.file_size << " bytes, but is " << size << " bytes.";
+    }
+    if (verify && (template_bank::Checksum(
+                       data + sizeof(template_bank::FileHeader),
+                       size - sizeof(template_bank::FileHeader)) !=
+                   hdr.checksum)) {
+      throw invalid_template_bank()
+          << "[ERROR]: Template bank " << std::quoted(path)
+          << " failed its checksum, the file is corrupt.";
+    }
+
+    for (uint64_t t_it = 0; t_it < hdr.NTemplates; ++t_it) {
+      template_bank::DirectoryEntry entry =
+          Read<template_bank::DirectoryEntry>(
+              hdr.directory_offset +
+              t_it * sizeof(template_bank::DirectoryEntry));
+      if ((entry.key_offset + entry.key_size) > size) {
+        throw invalid_template_bank()
+            << "[ERROR]: Template bank " << std::quoted(path)
+            << " directory entry " << t_it << " has a key past the end of "
+            << "the file.";
+      }
+      directory[std::string(data + entry.key_offset, entry.key_size)] = entry;
+    }
+  }
+
+  TemplateBank(std::string const &bank_path, bool verify)
+      : path(bank_path), data(nullptr), size(0) {
+    Map();
+    try {
+      ReadDirectory(verify);
+    } catch (...) {
+      munmap(const_cast<char *>(data), size);
+      throw;
+    }
+  }
+
+public:
+  TemplateBank(TemplateBank const &) = delete;
+  TemplateBank &operator=(TemplateBank const &) = delete;
+
+  ~TemplateBank() { munmap(const_cast<char *>(data), size); }
+
+  /// Maps the bank at bank_path, or returns the existing mapping if it is
+  /// already open in this process.
+  ///
+  /// With verify set, the checksum of the whole file is checked when it is
+  /// first mapped, which reads every page once.
+  static std::shared_ptr<TemplateBank const> Open(std::string const &bank_path,
+                                                  bool verify = true) {
+    static std::mutex open_mutex;
+    static std::map<std::string, std::weak_ptr<TemplateBank const>> open_banks;
+
+    std::lock_guard<std::mutex> lock(open_mutex);
+    std::shared_ptr<TemplateBank const> bank = open_banks[bank_path].lock();
+    if (!bank) {
+      bank = std::shared_ptr<TemplateBank const>(
+          new TemplateBank(bank_path, verify));
+      open_banks[bank_path] = bank;
+    }
+    return bank;
+  }
+
+  std::string const &GetPath() const { return path; }
+  size_t GetNTemplates() const { return directory.size(); }
+
+  /// Returns false if the bank holds no template under key.
+  bool FindTemplate(std::string const &key, Template &tmpl) const {
+    auto entry = directory.find(key);
+    if (entry == directory.end()) {
+      return false;
+    }
+    uint64_t offset = entry->second.template_offset;
+    template_bank::TemplateHeader hdr =
+        Read<template_bank::TemplateHeader>(offset);
+    offset += sizeof(template_bank::TemplateHeader);
+
+    tmpl.Axes.clear();
+    for (uint32_t d_it = 0; d_it < hdr.NDims; ++d_it) {
+      template_bank::AxisHeader axis =
+          Read<template_bank::AxisHeader>(offset);
+      offset += sizeof(template_bank::AxisHeader);
+      if (axis.IsUniform) {
+        tmpl.Axes.emplace_back(axis.NBins, axis.Low, axis.High);
+        continue;
+      }
+      double const *edges = ReadArray(offset, axis.NBins + 1);
+      tmpl.Axes.emplace_back(
+          std::vector<double>(edges, edges + axis.NBins + 1));
+      offset += (axis.NBins + 1) * sizeof(double);
+    }
+
+    tmpl.NValues = hdr.NValues;
+    tmpl.Values = ReadArray(hdr.values_offset, hdr.NValues);
+    tmpl.NFlatBins = hdr.NFlatBins;
+    tmpl.Responses =
+        ReadArray(hdr.responses_offset, hdr.NFlatBins * hdr.NValues);
+    return true;
+  }
+};
+
+/// Collects templates in memory and writes them out as a TemplateBank.
+class TemplateBankWriter {
+  struct Entry {
+    std::vector<AxisLookup> Axes;
+    std::vector<double> Values;
+    std::vector<double> Responses;
+  };
+  std::map<std::string, Entry> Entries;
+  std::mutex mtx;
+
+  static void Pad(std::vector<char> &buf, size_t alignment) {
+    buf.resize(((buf.size() + alignment - 1) / alignment) * alignment, 0);
+  }
+  template <typename T> static void Append(std::vector<char> &buf, T const &v) {
+    char const *bytes = reinterpret_cast<char const *>(&v);
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+  }
+  static void Append(std::vector<char> &buf, std::vector<double> const &v) {
+    char const *bytes = reinterpret_cast<char const *>(v.data());
+    buf.insert(buf.end(), bytes, bytes + v.size() * sizeof(double));
+  }
+  template <typename T>
+  static void Overwrite(std::vector<char> &buf, size_t offset, T const &v) {
+    std::memcpy(buf.data() + offset, &v, sizeof(T));
+  }
+
+public:
+  /// Set while converting input manifests, so that every template loaded
+  /// from ROOT files is also recorded here.
+  static TemplateBankWriter *&Recording() {
+    static TemplateBankWriter *writer = nullptr;
+    return writer;
+  }
+
+  /// responses are laid out [bin][value] over NFlatBins bins. Only the first
+  /// template added under each key is kept.
+  void AddTemplate(std::string const &key, std::vector<AxisLookup> axes,
+                   std::vector<double> values, double const *responses,
+                   size_t NFlatBins) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (Entries.count(key)) {
+      return;
+    }
+    Entry &entry = Entries[key];
+    entry.Axes = std::move(axes);
+    entry.Values = std::move(values);
+    entry.Responses.assign(responses,
+                           responses + NFlatBins * entry.Values.size());
+  }
+
+  size_t GetNTemplates() const { return Entries.size(); }
+
+  /// Writes to a temporary file that is then renamed over bank_path, so that
+  /// processes which have the old bank mapped are unaffected.
+  void Write(std::string const &bank_path) const {
+    std::vector<char> buf(sizeof(template_bank::FileHeader), 0);
+
+    std::vector<template_bank::DirectoryEntry> directory;
+    for (auto const &key_entry : Entries) {
+      template_bank::DirectoryEntry dentry{};
+      dentry.key_offset = buf.size();
+      dentry.key_size = key_entry.first.size();
+      buf.insert(buf.end(), key_entry.first.begin(), key_entry.first.end());
+      directory.push_back(dentry);
+    }
+    Pad(buf, 8);
+
+    size_t directory_offset = buf.size();
+    buf.resize(buf.size() +
+                   directory.size() * sizeof(template_bank::DirectoryEntry),
+               0);
+
+    size_t t_it = 0;
+    for (auto const &key_entry : Entries) {
+      Entry const &entry = key_entry.second;
+      size_t NValues = entry.Values.size();
+
+      size_t header_offset = buf.size();
+      directory[t_it].template_offset = header_offset;
+      Append(buf, template_bank::TemplateHeader{});
+      for (AxisLookup const &axis : entry.Axes) {
+        template_bank::AxisHeader ahdr{};
+        ahdr.IsUniform = axis.HasUniformBins();
+        ahdr.NBins = uint32_t(axis.GetNBins());
+        ahdr.Low = axis.GetLow();
+        ahdr.High = axis.GetHigh();
+        Append(buf, ahdr);
+        if (!axis.HasUniformBins()) {
+          Append(buf, axis.GetEdges());
+        }
+      }
+
+      template_bank::TemplateHeader thdr{};
+      thdr.NDims = uint32_t(entry.Axes.size());
+      thdr.NValues = uint32_t(NValues);
+      thdr.NFlatBins = NValues ? (entry.Responses.size() / NValues) : 0;
+      thdr.values_offset = buf.size();
+      Append(buf, entry.Values);
+      Pad(buf, 64);
+      thdr.responses_offset = buf.size();
+      Append(buf, entry.Responses);
+      Overwrite(buf, header_offset, thdr);
+
+      directory[t_it].template_size = buf.size() - header_offset;
+      t_it++;
+    }
+    Pad(buf, 8);
+
+    for (size_t d_it = 0; d_it < directory.size(); ++d_it) {
+      Overwrite(buf,
+                directory_offset + d_it * sizeof(template_bank::DirectoryEntry),
+                directory[d_it]);
+    }
+
+    template_bank::FileHeader hdr{};
+    std::memcpy(hdr.magic, template_bank::kMagic, 8);
+    hdr.version = template_bank::kVersion;
+    hdr.byte_order_mark = template_bank::kByteOrderMark;
+    hdr.file_size = buf.size();
+    hdr.NTemplates = directory.size();
+    hdr.directory_offset = directory_offset;
+    hdr.checksum =
+        template_bank::Checksum(buf.data() + sizeof(template_bank::FileHeader),
+                                buf.size() - sizeof(template_bank::FileHeader));
+    Overwrite(buf, 0, hdr);
+
+    std::string tmp_path = bank_path + ".tmp";
+    {
+      std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+      out.write(buf.data(), std::streamsize(buf.size()));
+      if (!out.good()) {
+        throw invalid_template_bank()
+            << "[ERROR]: Failed to write template bank to "
+            << std::quoted(tmp_path) << ".";
+      }
+    }
+    if (std::rename(tmp_path.c_str(), bank_path.c_str())) {
+      throw invalid_template_bank()
+          << "[ERROR]: Failed to move " << std::quoted(tmp_path) << " to "
+          << std::quoted(bank_path) << ": " << std::strerror(errno);
+    }
+  }
+};
+
+} // namespace nusyst
+
+#endif
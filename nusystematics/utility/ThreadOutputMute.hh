@@ -0,0 +1,64 @@
+#ifndef nusystematics_UTILITY_THREADOUTPUTMUTE_SEEN
+#define nusystematics_UTILITY_THREADOUTPUTMUTE_SEEN
+
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+
+namespace nusyst {
+
+/// Stream buffer that forwards to another, except for output written by a
+/// thread that holds a ScopedThreadOutputMute, which is discarded.
+///
+/// Installed once in place of a stream's buffer, muting a thread then only
+/// changes thread-local state.
+class ThreadMutableStreambuf : public std::streambuf {
+  std::streambuf *target;
+
+protected:
+  int overflow(int c) {
+    if (GetMuteDepth() || traits_type::eq_int_type(c, traits_type::eof())) {
+      return traits_type::not_eof(c);
+    }
+    return target->sputc(traits_type::to_char_type(c));
+  }
+  std::streamsize xsputn(char const *s, std::streamsize n) {
+    return GetMuteDepth() ? n : target->sputn(s, n);
+  }
+  int sync() { return GetMuteDepth() ? 0 : target->pubsync(); }
+
+public:
+  explicit ThreadMutableStreambuf(std::streambuf *t) : target(t) {}
+
+  static size_t &GetMuteDepth() {
+    thread_local size_t depth = 0;
+    return depth;
+  }
+
+  /// Wraps the buffer of os, once per stream. The wrapper is never removed,
+  /// or freed, as other threads may be writing through it.
+  static void Install(std::ostream &os) {
+    static std::mutex install_mutex;
+    std::lock_guard<std::mutex> lock(install_mutex);
+    if (dynamic_cast<ThreadMutableStreambuf *>(os.rdbuf())) {
+      return;
+    }
+    os.rdbuf(new ThreadMutableStreambuf(os.rdbuf()));
+  }
+};
+
+/// Discards what the current thread writes to streams with an installed
+/// ThreadMutableStreambuf for the lifetime of the guard, other threads are
+/// unaffected.
+class ScopedThreadOutputMute {
+public:
+  ScopedThreadOutputMute() { ThreadMutableStreambuf::GetMuteDepth()++; }
+  ~ScopedThreadOutputMute() { ThreadMutableStreambuf::GetMuteDepth()--; }
+
+  ScopedThreadOutputMute(ScopedThreadOutputMute const &) = delete;
+  ScopedThreadOutputMute &operator=(ScopedThreadOutputMute const &) = delete;
+};
+
+} // namespace nusyst
+
+#endif
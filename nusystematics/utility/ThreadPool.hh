@@ -0,0 +1,143 @@
+#ifndef nusystematics_UTILITY_THREADPOOL_SEEN
+#define nusystematics_UTILITY_THREADPOOL_SEEN
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nusyst {
+
+/// Fixed set of worker threads for running the iterations of a loop
+/// concurrently.
+///
+/// The calling thread takes part in each ParallelFor, so a pool of N threads
+/// starts N - 1 workers.
+class ThreadPool {
+  std::vector<std::thread> workers;
+
+  std::mutex mtx;
+  std::condition_variable work_cv;
+  std::condition_variable done_cv;
+
+  // State of the current ParallelFor, guarded by mtx apart from next.
+  std::function<void(size_t)> const *job;
+  size_t job_size;
+  size_t generation;
+  size_t NBusy;
+  bool stopping;
+  std::atomic<size_t> next;
+  std::exception_ptr first_error;
+
+  void RunJob(std::function<void(size_t)> const &fn, size_t n) {
+    for (size_t i = next++; i < n; i = next++) {
+      try {
+        fn(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!first_error) {
+          first_error = std::current_exception();
+        }
+      }
+    }
+  }
+
+  void WorkerLoop() {
+    size_t seen_generation = 0;
+    while (true) {
+      std::function<void(size_t)> const *fn;
+      size_t n;
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        work_cv.wait(lock, [&]() {
+          return stopping || (generation != seen_generation);
+        });
+        if (stopping) {
+          return;
+        }
+        seen_generation = generation;
+        if (!job) { // Woke after the caller had already finished this job
+          continue;
+        }
+        fn = job;
+        n = job_size;
+        NBusy++;
+      }
+      RunJob(*fn, n);
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        NBusy--;
+      }
+      done_cv.notify_one();
+    }
+  }
+
+public:
+  explicit ThreadPool(size_t NThreads)
+      : job(nullptr), job_size(0), generation(0), NBusy(0), stopping(false),
+        next(0) {
+    for (size_t th_it = 1; th_it < NThreads; ++th_it) {
+      workers.emplace_back([this]() { WorkerLoop(); });
+    }
+  }
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stopping = true;
+    }
+    work_cv.notify_all();
+    for (std::thread &w : workers) {
+      w.join();
+    }
+  }
+
+  size_t GetNThreads() const { return workers.size() + 1; }
+
+  /// Calls fn(i) for each i in [0, n) and returns once all calls have
+  /// finished, rethrowing the first exception thrown by any of them.
+  ///
+  /// Must not be called concurrently or from within fn.
+  void ParallelFor(size_t n, std::function<void(size_t)> const &fn) {
+    if (!workers.size() || (n < 2)) {
+      for (size_t i = 0; i < n; ++i) {
+        fn(i);
+      }
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      job = &fn;
+      job_size = n;
+      next = 0;
+      first_error = nullptr;
+      generation++;
+    }
+    work_cv.notify_all();
+
+    RunJob(fn, n);
+
+    std::exception_ptr err;
+    {
+      // Workers that picked up this job must have let go of fn before it goes
+      // out of scope, those that have yet to wake will find no job.
+      std::unique_lock<std::mutex> lock(mtx);
+      done_cv.wait(lock, [&]() { return !NBusy; });
+      job = nullptr;
+      err = first_error;
+    }
+    if (err) {
+      std::rethrow_exception(err);
+    }
+  }
+};
+
+} // namespace nusyst
+
+#endif